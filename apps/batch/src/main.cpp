@@ -1,11 +1,21 @@
+#include <algorithm>
+#include <atomic>
+#include <ccad/base/Execution.hpp>
 #include <ccad/base/Shape.hpp>
 #include <ccad/io/Export.hpp>
 #include <ccad/lua/LuaEngine.hpp>
 #include <chrono>
+#include <cmath>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 #include <optional>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -13,13 +23,29 @@ namespace fs = std::filesystem;
 struct Options {
     fs::path inDir;
     fs::path outDir;
-    double deflection = 0.2;  // Tesselation
-    bool failFast = false;    // quit with first error
-    bool quiet = false;       // less verbose
+    std::optional<double> deflection;                                   // absolute tessellation override
+    ccad::geom::MeshQuality quality = ccad::geom::MeshQuality::Normal;  // size-relative tessellation
+    bool failFast = false;                                              // quit with first error
+    bool quiet = false;                                                 // less verbose
+    bool ascii = false;                                                 // ASCII instead of binary STL
+    size_t jobs = 0;                                                    // parallel files, 0 = kernel budget
 };
 
+/// Outcome of one converted file.
+struct FileResult {
+    fs::path rel;
+    bool ok = false;
+    double ms = 0.0;  // evaluation, meshing and export
+    size_t triangles = 0;
+};
+
+/// Per-file times of earlier runs, kept in the output directory to schedule long files first.
+const char* const TIMINGS_FILENAME = ".batch_timings";
+
 static void printUsage(const char* argv0) {
-    std::cerr << "Usage: " << argv0 << " --in <dir> --out <dir> [--defl 0.2] [--fail-fast] [--quiet]\n";
+    std::cerr << "Usage: " << argv0
+              << " --in <dir> --out <dir> [--quality draft|normal|fine|legacy] [--defl 0.2] [--fail-fast] [--quiet]"
+                 " [--ascii] [--jobs N]\n";
 }
 
 std::shared_ptr<ccad::lua::LuaEngine> GetEngine() {
@@ -44,6 +70,21 @@ std::shared_ptr<ccad::lua::LuaEngine> GetEngine() {
     return engine;
 }
 
+static std::unordered_map<std::string, double> LoadTimings(const fs::path& file) {
+    std::unordered_map<std::string, double> timings;
+    std::ifstream in(file);
+    double ms;
+    std::string rel;
+    while (in >> ms && std::getline(in >> std::ws, rel)) timings[rel] = ms;
+    return timings;
+}
+
+static void SaveTimings(const fs::path& file, const std::unordered_map<std::string, double>& timings) {
+    std::ofstream out(file);
+    for (const auto& [rel, ms] : timings) out << ms << ' ' << rel << '\n';
+    if (!out) std::cerr << "WARNING: could not write " << file << "\n";
+}
+
 static std::optional<Options> parseArgs(int argc, char** argv) {
     Options opt;
     for (int i = 1; i < argc; ++i) {
@@ -54,10 +95,29 @@ static std::optional<Options> parseArgs(int argc, char** argv) {
             opt.outDir = argv[++i];
         } else if (a == "--defl" && i + 1 < argc) {
             opt.deflection = std::stod(argv[++i]);
+        } else if (a == "--quality" && i + 1 < argc) {
+            if (!ccad::geom::ParseMeshQuality(argv[++i], opt.quality)) {
+                std::cerr << "Unknown quality: " << argv[i] << "\n";
+                printUsage(argv[0]);
+                return std::nullopt;
+            }
         } else if (a == "--fail-fast") {
             opt.failFast = true;
         } else if (a == "--quiet") {
             opt.quiet = true;
+        } else if (a == "--ascii") {
+            opt.ascii = true;
+        } else if ((a == "--jobs" || a == "-j") && i + 1 < argc) {
+            try {
+                size_t end = 0;
+                const long n = std::stol(argv[++i], &end);
+                if (n < 0 || argv[i][end] != '\0') throw std::invalid_argument("jobs");
+                opt.jobs = static_cast<size_t>(n);
+            } catch (const std::exception&) {
+                std::cerr << "Invalid job count: " << argv[i] << "\n";
+                printUsage(argv[0]);
+                return std::nullopt;
+            }
         } else if (a == "--help" || a == "-h") {
             printUsage(argv[0]);
             return std::nullopt;
@@ -96,65 +156,120 @@ int main(int argc, char** argv) {
         std::cout << "Found " << luaFiles.size() << " Lua files in " << opt.inDir << "\n";
     }
 
-    size_t ok = 0, fail = 0;
-    std::chrono::milliseconds totalMs{0};
-
+    // Longest first by the times of the previous run; files without a time go first, they may be long too
+    const fs::path timingsFile = opt.outDir / TIMINGS_FILENAME;
+    auto timings = LoadTimings(timingsFile);
+    std::vector<std::pair<double, fs::path>> order;
     for (const auto& lua : luaFiles) {
-        fs::path rel = fs::relative(lua, opt.inDir);
-        fs::path out = opt.outDir / rel;
-        out.replace_extension(".stl");
+        auto it = timings.find(fs::relative(lua, opt.inDir).generic_string());
+        order.emplace_back(it == timings.end() ? 1e300 : it->second, lua);
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    for (size_t i = 0; i < order.size(); ++i) luaFiles[i] = order[i].second;
+
+    auto params = ccad::lua::GetTriangulationParameters(opt.quality);
+    if (opt.deflection) {
+        params.linearDeflection = *opt.deflection;
+        params.relativeDeflection = 0.0;
+    }
+
+    if (opt.jobs) ccad::SetWorkerCount(opt.jobs);
+    const size_t jobs = std::max<size_t>(1, std::min(ccad::WorkerCount(), luaFiles.size()));
+
+    // One engine per worker, reused for all files the worker converts
+    std::vector<std::shared_ptr<ccad::lua::LuaEngine>> engines;
+    for (size_t j = 0; j < jobs; ++j) {
+        engines.push_back(GetEngine());
+        engines.back()->SetTriangulationParameters(params);
+    }
+
+    std::vector<FileResult> results(luaFiles.size());
+    std::atomic<size_t> next{0};
+    std::atomic<bool> stop{false};
+    std::mutex outputMutex;
+
+    auto convert = [&](ccad::lua::LuaEngine& engine, const fs::path& lua, const fs::path& out, FileResult& r) {
         fs::create_directories(out.parent_path());
+        auto fail = [&](const std::string& msg) {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            std::cerr << "  ERROR in " << r.rel.string() << ": " << msg << std::endl;
+        };
+        if (!engine.RunFile(lua.string())) return fail("script failed");
 
-        if (!opt.quiet) {
-            std::cout << "[RUN] " << rel.string() << " -> " << out.string() << "\n";
-        }
+        auto emitted = engine.GetEmitted();
+        if (!emitted) return fail("script did not call emit(...)");
 
-        auto engine = GetEngine();
-
-        auto t0 = std::chrono::steady_clock::now();
-        bool ran = engine->RunFile(lua.string());
-        auto t1 = std::chrono::steady_clock::now();
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0);
-        totalMs += ms;
-
-        if (!ran) {
-            std::cerr << "  ERROR in " << rel.string() << std::endl;
-            fail++;
-            if (opt.failFast)
-                break;
-            else
-                continue;
-        }
+        r.triangles = ccad::geom::TriangulateShared(emitted.value(), params)->indices.size() / 3;
+        ccad::io::StlOptions stlOpt;
+        if (opt.ascii) stlOpt.format = ccad::io::StlFormat::Ascii;
+        if (!ccad::io::SaveSTL(emitted.value(), out.string(), params, stlOpt)) return fail("failed to write STL");
+        r.ok = true;
+    };
 
-        auto emitted = engine->GetEmitted();
-        if (!emitted) {
-            std::cerr << "  ERROR: script did not call emit(...)\n";
-            fail++;
-            if (opt.failFast)
-                break;
-            else
-                continue;
-        }
+    auto worker = [&](ccad::lua::LuaEngine& engine) {
+        ccad::WorkerScope scope;
+        for (size_t i; !stop && (i = next++) < luaFiles.size();) {
+            FileResult& r = results[i];
+            r.rel = fs::relative(luaFiles[i], opt.inDir);
+            fs::path out = opt.outDir / r.rel;
+            out.replace_extension(".stl");
 
-        auto params = ccad::lua::GetTriangulationParameters();
-        params.linearDeflection = opt.deflection;
-        if (!ccad::io::SaveSTL(emitted.value(), out.string(), params)) {
-            std::cerr << "  ERROR: failed to write STL\n";
-            fail++;
-            if (opt.failFast)
-                break;
-            else
-                continue;
-        }
+            const auto t0 = std::chrono::steady_clock::now();
+            try {
+                convert(engine, luaFiles[i], out, r);
+            } catch (const std::exception& e) {
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cerr << "  ERROR in " << r.rel.string() << ": " << e.what() << std::endl;
+            }
+            r.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            if (!r.ok && opt.failFast) stop = true;
 
-        if (!opt.quiet) {
-            std::cout << "  OK (" << ms.count() << " ms)\n";
+            if (r.ok && !opt.quiet) {
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << "[OK] " << r.rel.string() << " -> " << out.string() << " (" << std::lround(r.ms)
+                          << " ms, " << r.triangles << " triangles)\n";
+            }
         }
-        ok++;
+    };
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t j = 0; j < jobs; ++j) workers.emplace_back(worker, std::ref(*engines[j]));
+    for (auto& w : workers) w.join();
+    const double wallMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+
+    size_t ok = 0, fail = 0;
+    double totalMs = 0.0;
+    std::vector<const FileResult*> processed;
+    for (const auto& r : results) {
+        if (r.rel.empty()) continue;  // not started, after --fail-fast
+        (r.ok ? ok : fail)++;
+        totalMs += r.ms;
+        processed.push_back(&r);
+        timings[r.rel.generic_string()] = r.ms;
     }
+    SaveTimings(timingsFile, timings);
+
+    const size_t files = ok + fail;
+    std::cout << "\nSummary: OK=" << ok << "  FAIL=" << fail << "  Total=" << std::lround(totalMs)
+              << " ms  Avg=" << (files > 0 ? std::lround(totalMs / files) : 0) << " ms/file\n";
+    std::ostringstream rate;
+    rate.setf(std::ios::fixed);
+    rate.precision(2);
+    rate << (wallMs > 0.0 ? files * 1000.0 / wallMs : 0.0);
+    std::cout << "Wall=" << std::lround(wallMs) << " ms  Throughput=" << rate.str() << " files/s  (" << jobs
+              << (jobs == 1 ? " job" : " jobs") << ")\n";
 
-    std::cout << "\nSummary: OK=" << ok << "  FAIL=" << fail << "  Total=" << totalMs.count()
-              << " ms  Avg=" << (ok + fail > 0 ? totalMs.count() / (ok + fail) : 0) << " ms/file\n";
+    const size_t slowest = std::min<size_t>(5, processed.size());
+    std::partial_sort(processed.begin(), processed.begin() + slowest, processed.end(),
+                      [](const FileResult* a, const FileResult* b) { return a->ms > b->ms; });
+    if (slowest) std::cout << "Slowest:\n";
+    for (size_t i = 0; i < slowest; ++i) {
+        std::cout << "  " << std::lround(processed[i]->ms) << " ms  " << processed[i]->rel.string() << "\n";
+    }
 
     return (fail == 0) ? 0 : 1;
 }
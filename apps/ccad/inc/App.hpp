@@ -11,7 +11,7 @@ class App {
    private:
     void handleNew(const std::string& name, const std::string& unit);
     void handlePartsAdd(const std::string& partName, const std::string& partMatName);
-    void handleBuild(const std::string& rootDir);
+    bool handleBuild(const std::string& rootDir, const BuildOptions& opt);
     void handleLive(const std::string& rootDir);
     void handleParamsSet(const std::string& key, const std::string& value);
     void handleMaterialSet(const std::string& name, const std::string& color);
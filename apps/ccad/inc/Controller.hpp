@@ -1,10 +1,14 @@
 #pragma once
+#include <ccad/io/Stl.hpp>
 #include <ccad/lua/LuaEngine.hpp>
 #include <memory>
+#include <optional>
 #include <pure/PureController.hpp>
 #include <pure/PurePicker.hpp>
 
 #include "FileWatcher.hpp"
+#include "LiveBuilder.hpp"
+#include "PartCache.hpp"
 #include "Project.hpp"
 #include "pure/PureMeasurement.hpp"
 
@@ -12,11 +16,35 @@ namespace fs = std::filesystem;
 
 enum class AppMode { Orbit, Measure };
 
+/// Options for `ccad build`.
+struct BuildOptions {
+    bool asciiStl = false;    // write ASCII instead of binary STL
+    bool meshReport = false;  // also mesh with the legacy preset and report both triangle counts
+    bool useCache = true;     // load unchanged parts from the project's part cache
+};
+
+/// Result and timings of one part in `ccad build`.
+struct PartBuild {
+    std::string stem;
+    std::string key;  // part cache key
+    std::optional<ccad::Shape> shape;
+    bool fromCache = false;
+    bool exported = false;
+    size_t triangles = 0;
+    size_t legacy = 0;
+    double deflection = 0.0;
+    double evalMs = 0.0;
+    double meshMs = 0.0;
+    double exportMs = 0.0;
+};
+
 class Controller {
    public:
     Controller(std::vector<std::string>& luaPaths);
     void LoadProject(const fs::path& projectDir);
-    void BuildProject();
+    /// Evaluate and export all parts; false if any part failed.
+    bool BuildProject(const BuildOptions& opt = {});
+    void SetMeshQuality(ccad::geom::MeshQuality quality);
     void ViewProject();
     void CreateBom();
 
@@ -24,6 +52,8 @@ class Controller {
 
    private:
     void SetupEngine();
+    // Initialized engine with the project's library paths (PARAMS are applied by the caller)
+    std::shared_ptr<ccad::lua::LuaEngine> CreateEngine() const;
 
     // --- Watcher lifecycle ---
     void SetupWatchers();
@@ -38,9 +68,26 @@ class Controller {
     void RebuildAllParts();
     void RebuildPartByPath(const std::string& luaPath);
 
+    // Tessellation for a part: build/live quality, overridden by the part's "mesh" settings
+    ccad::geom::TriangulationParams MeshParamsFor(const Part& part) const;
+
+    // Shape of a part: loaded from `cache` under `key`, or evaluated on `engine` and stored (updating `key`).
+    // A cancelled run, or one whose script was edited meanwhile, is not stored and `key` is cleared.
+    std::optional<ccad::Shape> EvaluatePart(ccad::lua::LuaEngine& engine, const fs::path& luaFile,
+                                            const ParamsMap& params, PartCache* cache, std::string& key,
+                                            bool* fromCache = nullptr) const;
+
+    // `ccad build` export stage: mesh (or load the cached mesh) and write STL and STEP
+    void ExportPart(const Part& part, PartBuild& b, const fs::path& outDir, PartCache* cache,
+                    const ccad::io::StlOptions& stlOpt, bool meshReport) const;
+    static size_t PrintBuildReport(const std::vector<PartBuild>& builds, bool meshReport);
+
     // --- Scene utils ---
-    void ClearScene();
-    void AddPartToScene(const Part& part);
+    // Live rebuilds: queued on m_LiveBuilder, swapped into the scene by ApplyFinishedBuilds() each frame
+    void QueuePartBuild(const Part& part);
+    LivePartMesh BuildLivePart(ccad::lua::LuaEngine& engine, const Part& part, const fs::path& luaFile,
+                               const ParamsMap& params, const ccad::CancelToken& cancel) const;
+    void ApplyFinishedBuilds();
     static std::string NormalizePath(const std::string& p);
 
    private:
@@ -68,5 +115,11 @@ class Controller {
     int m_DebounceMs = 200;
 
     std::shared_ptr<ccad::lua::LuaEngine> m_Engine;
+    std::unique_ptr<PartCache> m_PartCache;
+    bool m_FitCameraPending = false;
+
+    // Last member: destroyed first, its workers use the members above
+    std::unique_ptr<LiveBuilder> m_LiveBuilder;
+    ccad::geom::MeshQuality m_MeshQuality{ccad::geom::MeshQuality::Normal};
     std::vector<std::string> m_LuaPaths;
 };
@@ -0,0 +1,85 @@
+#pragma once
+#include <ccad/base/Progress.hpp>
+#include <ccad/lua/LuaEngine.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <pure/PureTypes.hpp>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// Mesh of a part built in the background, ready to be uploaded by the render thread.
+struct LivePartMesh {
+    std::string partId;
+    std::vector<pure::PureVertex> vertices;
+    std::vector<unsigned> indices;
+    bool hasNormals = false;
+    bool ok = false;  // false: the build failed, keep showing the previous geometry
+};
+
+/**
+ * @brief Worker pool for the live viewer's part rebuilds.
+ *
+ * Each worker owns a LuaEngine, so scripts of different parts evaluate concurrently while the
+ * render thread keeps drawing. A newer build of a part supersedes the older one: a queued build
+ * is dropped, a running one is cancelled through its OperationContext (the Lua hook and the
+ * kernel operations stop within milliseconds) and its result discarded. The newer build only
+ * starts once the cancelled one has returned, so two generations of a part never run at once.
+ */
+class LiveBuilder {
+   public:
+    using EngineFactory = std::function<std::shared_ptr<ccad::lua::LuaEngine>()>;
+    /// Builds one part; runs inside an OperationContext with `cancel` and should return early once it is set.
+    using Job = std::function<LivePartMesh(ccad::lua::LuaEngine& engine, const ccad::CancelToken& cancel)>;
+
+    LiveBuilder(size_t workers, EngineFactory factory);
+    ~LiveBuilder();
+
+    LiveBuilder(const LiveBuilder&) = delete;
+    LiveBuilder& operator=(const LiveBuilder&) = delete;
+
+    /// Queue a build of `partId`, superseding any pending build of the same part.
+    void Submit(const std::string& partId, Job job);
+
+    /// Results of the latest builds finished since the last call (render thread).
+    std::vector<LivePartMesh> TakeFinished();
+
+    /// True while the latest build of `partId` is queued or running.
+    bool IsBuilding(const std::string& partId) const;
+
+    /// True if no build is queued or running.
+    bool Idle() const;
+
+   private:
+    struct Task {
+        std::string partId;
+        uint64_t generation = 0;
+        Job job;
+        ccad::CancelToken cancel;
+    };
+    struct Latest {
+        uint64_t generation = 0;
+        ccad::CancelToken cancel;
+        bool done = false;
+        bool running = false;  // some generation of the part is on a worker
+    };
+
+    /// First queued task whose part is not running; m_Queue.end() if none (m_Mutex held).
+    std::deque<Task>::iterator NextTaskLocked();
+    void WorkerLoop();
+
+    EngineFactory m_Factory;
+    std::vector<std::thread> m_Workers;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    std::deque<Task> m_Queue;
+    std::unordered_map<std::string, Latest> m_Latest;
+    std::vector<LivePartMesh> m_Finished;
+    uint64_t m_Generation = 0;
+    bool m_Stop = false;
+};
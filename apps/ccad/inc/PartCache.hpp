@@ -0,0 +1,57 @@
+#pragma once
+#include <ccad/base/Shape.hpp>
+#include <ccad/geom/Triangulation.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Project.hpp"
+
+/**
+ * @brief Persistent, content-addressed cache of part results (`<project>/.ccad/cache`).
+ *
+ * A part's key hashes its script, the library files it required on its last evaluation, the
+ * project params and the kernel version, so unchanged parts are loaded instead of re-evaluated.
+ * Files the script reads itself (io.open, dofile) are not part of the key.
+ * Each key stores the exact B-rep plus any number of meshes (one per tessellation variant).
+ * Least recently used files are evicted once the directory exceeds its size budget.
+ */
+class PartCache {
+   public:
+    static constexpr uintmax_t kDefaultBudget = uintmax_t(1) << 30;  // 1 GiB
+
+    explicit PartCache(std::filesystem::path dir, uintmax_t budgetBytes = kDefaultBudget);
+
+    /// Key of the result of `script` with the dependencies of its last evaluation; empty if it cannot be read.
+    std::string KeyFor(const std::filesystem::path& script, const ParamsMap& params) const;
+
+    /// Key of a result evaluated from `source` (the script text read before the run) requiring `deps`.
+    std::string KeyForSource(const std::string& source, const std::vector<std::string>& deps,
+                             const ParamsMap& params) const;
+
+    /// Text of `script`, or nullopt if it cannot be read.
+    static std::optional<std::string> ReadScript(const std::filesystem::path& script);
+
+    /// Remember the library files `script` required, they are part of its key from now on.
+    void RecordDependencies(const std::filesystem::path& script, const std::vector<std::string>& files);
+
+    std::optional<ccad::Shape> LoadShape(const std::string& key);
+    void StoreShape(const std::string& key, const ccad::Shape& shape);
+
+    /// Meshes are stored per `variant`, see MeshVariant().
+    std::optional<ccad::geom::TriMesh> LoadMesh(const std::string& key, const std::string& variant);
+    void StoreMesh(const std::string& key, const std::string& variant, const ccad::geom::TriMesh& mesh);
+
+    /// Variant name for a mesh tessellated with `p` after applying the part transform `tr`.
+    static std::string MeshVariant(const ccad::geom::TriangulationParams& p, const PartTransform* tr = nullptr);
+
+   private:
+    std::filesystem::path DepsFile(const std::filesystem::path& script) const;
+    void Touch(const std::filesystem::path& p) const;
+    void Evict() const;
+
+    std::filesystem::path m_Dir;
+    uintmax_t m_Budget;
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Single-line progress display for `ccad build` on stderr.
+ *
+ * Shows the finished parts and, per worker slot, the part and kernel operation in progress.
+ * Thread-safe; redraws are throttled and nothing is printed unless stderr is a terminal.
+ */
+class ProgressBar {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    ProgressBar(size_t total, size_t slots) : m_Total(total), m_Slots(slots) {
+#ifndef _WIN32
+        m_Enabled = isatty(fileno(stderr)) != 0;
+#endif
+    }
+
+    ~ProgressBar() {
+        Finish();
+    }
+
+    /// Worker `slot` works on `part`; `stage` and `fraction` come from the kernel's progress sink.
+    void SetActivity(size_t slot, const std::string& part, const char* stage = nullptr, double fraction = 0.0) {
+        if (!m_Enabled) return;
+        std::ostringstream ss;
+        ss << part;
+        if (stage) ss << ": " << stage << " " << static_cast<int>(fraction * 100.0) << "%";
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (slot < m_Slots.size()) m_Slots[slot] = ss.str();
+        DrawLocked(false);
+    }
+
+    void ClearActivity(size_t slot) {
+        if (!m_Enabled) return;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (slot < m_Slots.size()) m_Slots[slot].clear();
+    }
+
+    /// One more part is completely done (evaluated and exported).
+    void PartDone() {
+        if (!m_Enabled) return;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ++m_Done;
+        DrawLocked(true);
+    }
+
+    /// Remove the bar so regular output continues on a clean line.
+    void Finish() {
+        if (!m_Enabled) return;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (m_Drawn) std::cerr << "\r\033[K" << std::flush;
+        m_Enabled = false;
+        m_Drawn = false;
+    }
+
+   private:
+    static constexpr int kBarWidth = 24;
+    static constexpr size_t kMaxLine = 110;
+
+    void DrawLocked(bool force) {
+        if (!m_Enabled) return;  // finished meanwhile
+        const auto now = Clock::now();
+        if (!force && now - m_LastDraw < std::chrono::milliseconds(100)) return;
+        m_LastDraw = now;
+
+        const int filled = m_Total ? static_cast<int>(kBarWidth * m_Done / m_Total) : kBarWidth;
+        std::string line = "[" + std::string(filled, '#') + std::string(kBarWidth - filled, '-') + "] " +
+                           std::to_string(m_Done) + "/" + std::to_string(m_Total);
+        for (const auto& s : m_Slots) {
+            if (!s.empty()) line += "  " + s;
+        }
+        if (line.size() > kMaxLine) line.resize(kMaxLine);
+        std::cerr << "\r\033[K" << line << std::flush;
+        m_Drawn = true;
+    }
+
+    std::mutex m_Mutex;
+    size_t m_Total;
+    size_t m_Done = 0;
+    std::vector<std::string> m_Slots;
+    Clock::time_point m_LastDraw{};
+    std::atomic<bool> m_Enabled{false};
+    bool m_Drawn = false;
+};
@@ -18,6 +18,18 @@ struct PartTransform {
     double scale;
 };
 
+// Optional per-part tessellation override ("mesh" in project.json)
+struct PartMesh {
+    std::string quality;               // preset: draft, normal, fine, legacy; empty = build default
+    std::optional<double> deflection;  // absolute chordal deflection [mm]
+    std::optional<double> relative;    // deflection as fraction of the bbox diagonal
+    std::optional<double> angle;       // angular deflection [deg]
+
+    bool IsSet() const {
+        return !quality.empty() || deflection || relative || angle;
+    }
+};
+
 struct Material {
     std::string color;  // hex color
 };
@@ -29,6 +41,7 @@ struct Part {
     std::string material;  // material key
     bool visible;
     PartTransform transform;
+    PartMesh mesh;
 };
 
 struct Animation {
@@ -6,9 +6,12 @@
 class ProjectPanel {
    public:
     using SaveCallback = std::function<void(const Project&)>;
+    using BuildStatusCallback = std::function<bool(const std::string& partId)>;
 
     explicit ProjectPanel(Project& project);
     void SetOnSave(SaveCallback cb);
+    /// Tells whether a part is being rebuilt, shown next to its name.
+    void SetBuildStatus(BuildStatusCallback cb);
     void Draw();
     void ForceSaveNow();
 
@@ -20,6 +23,7 @@ class ProjectPanel {
    private:
     Project& m_Project;
     SaveCallback m_OnSave;
+    BuildStatusCallback m_IsBuilding;
     bool m_Dirty = false;
     std::chrono::steady_clock::time_point m_LastEdit = std::chrono::steady_clock::now();
     const int m_DebounceMs = 300;  // Save after debounce
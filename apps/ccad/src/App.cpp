@@ -1,6 +1,8 @@
 #include "App.hpp"
 
 #include <CLI/CLI.hpp>
+#include <ccad/base/Execution.hpp>
+#include <cstdlib>
 #include <filesystem>
 #include <nlohmann/json.hpp>
 #include <sstream>
@@ -77,11 +79,29 @@ reusable components, and integration with 3D printing workflows.
     std::string liveRoot = ".";
     auto* cmdLive = app.add_subcommand("live", "Start live viewer");
     cmdLive->add_option("root", liveRoot, "Project directory");
+    size_t jobs = 0;
+    const std::string jobsHelp = "Worker threads for parts and kernel operations (0 = $" +
+                                 std::string(ccad::kJobsEnvVar) + " or one per CPU core)";
+    cmdLive->add_option("-j,--jobs", jobs, jobsHelp);
+    const std::vector<std::string> qualities = {"draft", "normal", "fine", "legacy"};
+    std::string quality = "normal";
+    cmdLive->add_option("--quality", quality, "Tessellation quality")
+        ->check(CLI::IsMember(qualities))
+        ->capture_default_str();
 
     // build [<rootDir>]
     std::string buildRoot = ".";
     auto* cmdBuild = app.add_subcommand("build", "Generate STL files");
     cmdBuild->add_option("root", buildRoot, "Project directory");
+    BuildOptions buildOpt;
+    cmdBuild->add_flag("--ascii", buildOpt.asciiStl, "Write ASCII STL instead of binary");
+    cmdBuild->add_option("--quality", quality, "Tessellation quality")
+        ->check(CLI::IsMember(qualities))
+        ->capture_default_str();
+    cmdBuild->add_flag("--mesh-report", buildOpt.meshReport, "Compare triangle counts against the legacy tessellation");
+    cmdBuild->add_flag("!--no-cache", buildOpt.useCache,
+                       "Re-evaluate all parts instead of loading unchanged ones from .ccad/cache");
+    cmdBuild->add_option("-j,--jobs", jobs, jobsHelp);
 
     // params set key <key> value <value>
     auto* cmdParams = app.add_subcommand("params", "Handle project parameters");
@@ -117,8 +137,13 @@ reusable components, and integration with 3D printing workflows.
         std::exit(app.exit(e));
     }
 
+    if (jobs) ccad::SetWorkerCount(jobs);
+
     // Setup controller
     m_Controller = std::make_unique<Controller>(luaPaths);
+    ccad::geom::MeshQuality meshQuality = ccad::geom::MeshQuality::Normal;
+    ccad::geom::ParseMeshQuality(quality, meshQuality);
+    m_Controller->SetMeshQuality(meshQuality);
 
     // Dispatch manually
     if (*cmdLive) {
@@ -126,7 +151,7 @@ reusable components, and integration with 3D printing workflows.
         return;
     }
     if (*cmdBuild) {
-        handleBuild(buildRoot);
+        if (!handleBuild(buildRoot, buildOpt)) std::exit(EXIT_FAILURE);  // scripts and CI see failed parts
         return;
     }
     if (*cmdParts && *cmdAdd) {
@@ -194,7 +219,7 @@ void App::handleNew(const std::string& projectName, const std::string& unit) {
     const std::string readme = "# " + projectName + "\n";
     std::ofstream(rootDir / "README.md") << readme << readme_template;
 
-    std::ofstream(rootDir / ".gitignore") << PROJECT_OUTDIR << "/\n";
+    std::ofstream(rootDir / ".gitignore") << PROJECT_OUTDIR << "/\n.ccad/\n";
 
     // Also generate LSP files
     handleLspInit();
@@ -295,9 +320,9 @@ void App::handlePartsAdd(const std::string& partName, const std::string& partMat
     }
 }
 
-void App::handleBuild(const std::string& rootDir) {
+bool App::handleBuild(const std::string& rootDir, const BuildOptions& opt) {
     m_Controller->LoadProject(rootDir);
-    m_Controller->BuildProject();
+    return m_Controller->BuildProject(opt);
 }
 
 void App::handleLive(const std::string& rootDir) {
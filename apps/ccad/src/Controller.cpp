@@ -1,15 +1,27 @@
 #include "Controller.hpp"
 
+#include <ccad/base/Execution.hpp>
 #include <ccad/base/Logger.hpp>
+#include <ccad/base/Progress.hpp>
+#include <ccad/base/Stats.hpp>
 #include <ccad/io/Export.hpp>
 #include <ccad/lua/Bom.hpp>
 #include <ccad/lua/LuaEngine.hpp>
 #include <ccad/ops/Transform.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <exception>
 #include <filesystem>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
 
 #include "GLFW/glfw3.h"
+#include "ProgressBar.hpp"
 #include "ProjectPanel.hpp"
 #include "Time.hpp"
 #include "Utils.hpp"
@@ -22,9 +34,11 @@
 using namespace std;
 using namespace pure;
 namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
 
 const std::string PROJECT_FILENAME = "project.json";
 const std::string PROJECT_OUTDIR = "generated";
+const std::string PROJECT_CACHEDIR = ".ccad/cache";
 
 std::string Controller::NormalizePath(const std::string& p) {
     try {
@@ -43,11 +57,20 @@ static glm::vec3 ParseHexColor(const std::string& hex, glm::vec3 fallback = {0.7
     return {to01(r), to01(g), to01(b)};
 }
 
-static void ApplyProjectParamsToLua(sol::state& L, const Project& p) {
+static void ApplyProjectParamsToLua(sol::state& L, const ParamsMap& params) {
     sol::table P = L["PARAMS"];
     if (!P.valid()) P = L.create_named_table("PARAMS");
 
-    for (const auto& kv : p.params) {
+    // Params deleted from the project must not linger in a reused engine
+    std::vector<std::string> removed;
+    for (const auto& kv : P) {
+        if (kv.first.is<std::string>() && !params.count(kv.first.as<std::string>())) {
+            removed.push_back(kv.first.as<std::string>());
+        }
+    }
+    for (const auto& k : removed) P[k] = sol::lua_nil;
+
+    for (const auto& kv : params) {
         const auto& k = kv.first;
         const auto& v = kv.second;
         switch (v.type) {
@@ -72,14 +95,16 @@ ccad::Shape ApplyProjectTransform(const ccad::Shape& s, const PartTransform& tr)
     const bool noTrans = tr.translate.x == 0.0 && tr.translate.y == 0.0 && tr.translate.z == 0.0;
     if (noScale && noRot && noTrans) return s;
 
-    ccad::Shape out = s;
-    // gleiche Reihenfolge wie vorher: S, Rx, Ry, Rz, T
-    if (!noScale) out = ccad::ops::ScaleUniform(out, tr.scale);
-    if (tr.rotate.x != 0.0) out = ccad::ops::RotateX(out, tr.rotate.x);
-    if (tr.rotate.y != 0.0) out = ccad::ops::RotateY(out, tr.rotate.y);
-    if (tr.rotate.z != 0.0) out = ccad::ops::RotateZ(out, tr.rotate.z);
-    if (!noTrans) out = ccad::ops::Translate(out, tr.translate.x, tr.translate.y, tr.translate.z);
-    return out;
+    // S, Rx, Ry, Rz, T composed into a single placement
+    ccad::ops::Transform t;
+    t.scale = tr.scale;
+    t.rotateDeg = ccad::Vec3(tr.rotate.x, tr.rotate.y, tr.rotate.z);
+    t.translate = ccad::Vec3(tr.translate.x, tr.translate.y, tr.translate.z);
+    return ccad::ops::Apply(s, t);
+}
+
+static double MillisSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
 }
 
 Controller::Controller(std::vector<std::string>& luaPaths) : m_LuaPaths(luaPaths) {
@@ -102,11 +127,12 @@ void Controller::LoadProject(const fs::path& projectDir) {
     }
 
     SetupEngine();
-    ApplyProjectParamsToLua(m_Engine->Lua(), m_Project);
+    ApplyProjectParamsToLua(m_Engine->Lua(), m_Project.params);
+    m_PartCache = std::make_unique<PartCache>(fs::absolute(projectDir) / PROJECT_CACHEDIR);
 
     m_ProjectLoaded = true;
 }
-void Controller::BuildProject() {
+bool Controller::BuildProject(const BuildOptions& opt) {
     if (!m_ProjectLoaded) {
         throw std::runtime_error("No project is loaded!");
     }
@@ -117,26 +143,177 @@ void Controller::BuildProject() {
     auto outDir = projectRoot / PROJECT_OUTDIR;
     fs::create_directory(outDir);
 
-    for (const auto& jp : m_Project.parts) {
-        std::filesystem::path src = projectRoot / jp.source;
-        auto luaFile = std::filesystem::weakly_canonical(src);
+    ccad::io::StlOptions stlOpt;
+    if (opt.asciiStl) stlOpt.format = ccad::io::StlFormat::Ascii;
+    PartCache* cache = opt.useCache ? m_PartCache.get() : nullptr;
+
+    const auto& parts = m_Project.parts;
+    const size_t count = parts.size();
+    // One evaluation thread per worker of the kernel budget; their operations go parallel with what is left
+    const size_t jobs = std::max<size_t>(1, std::min(ccad::WorkerCount(), count));
+
+    // Every evaluation worker owns a Lua state; the first one reuses the project engine
+    std::vector<std::shared_ptr<ccad::lua::LuaEngine>> engines{m_Engine};
+    for (size_t j = 1; j < jobs; ++j) {
+        engines.push_back(CreateEngine());
+        ApplyProjectParamsToLua(engines.back()->Lua(), m_Project.params);
+    }
+
+    std::vector<PartBuild> builds(count);
+    std::atomic<size_t> next{0};
+    std::mutex readyMutex;
+    std::condition_variable readyCv;
+    std::deque<size_t> ready;
+
+    // One progress slot per evaluation worker, plus one for the export stage
+    ProgressBar progress(count, jobs + 1);
+    auto sinkFor = [&progress](size_t slot, const std::string& stem) {
+        progress.SetActivity(slot, stem);
+        return [&progress, slot, stem](const char* stage, double f) { progress.SetActivity(slot, stem, stage, f); };
+    };
+
+    // Stage 1: evaluate the scripts on `jobs` threads, handing finished parts to the export stage
+    const auto wallStart = Clock::now();
+    auto evaluate = [&](ccad::lua::LuaEngine& engine, size_t slot) {
+        ccad::WorkerScope scope;
+        for (size_t i; (i = next++) < count;) {
+            PartBuild& b = builds[i];
+            b.stem = fs::path(parts[i].source).stem().string();
+
+            const auto start = Clock::now();
+            ccad::OperationContext context(ccad::CancelToken(), sinkFor(slot, b.stem));
+            try {
+                // A part whose path cannot be resolved fails alone, like any other evaluation error
+                const auto luaFile = std::filesystem::weakly_canonical(projectRoot / parts[i].source);
+                engine.SetTriangulationParameters(MeshParamsFor(parts[i]));
+                b.key = cache ? cache->KeyFor(luaFile, m_Project.params) : std::string();
+                b.shape = EvaluatePart(engine, luaFile, m_Project.params, cache, b.key, &b.fromCache);
+            } catch (const std::exception& e) {
+                LOG(ERROR) << "Error during processing lua file " << parts[i].source << ": " << e.what();
+            } catch (...) {
+                // OCCT's Standard_Failure: fail the part instead of terminating the worker thread
+                LOG(ERROR) << "Error during processing lua file " << parts[i].source;
+            }
+            b.evalMs = MillisSince(start);
+            progress.ClearActivity(slot);
+            {
+                std::lock_guard<std::mutex> lock(readyMutex);
+                ready.push_back(i);
+            }
+            readyCv.notify_one();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (size_t j = 0; j < jobs; ++j) workers.emplace_back(evaluate, std::ref(*engines[j]), j);
+
+    // Stage 2: mesh and export on this thread in completion order, overlapping with the evaluation
+    for (size_t done = 0; done < count; ++done) {
+        size_t i;
+        {
+            std::unique_lock<std::mutex> lock(readyMutex);
+            readyCv.wait(lock, [&]() { return !ready.empty(); });
+            i = ready.front();
+            ready.pop_front();
+        }
+        try {
+            ccad::OperationContext context(ccad::CancelToken(), sinkFor(jobs, builds[i].stem));
+            ExportPart(parts[i], builds[i], outDir, cache, stlOpt, opt.meshReport);
+        } catch (const std::exception& e) {
+            LOG(ERROR) << "Export of " << builds[i].stem << " failed: " << e.what();
+        } catch (...) {
+            LOG(ERROR) << "Export of " << builds[i].stem << " failed";
+        }
+        progress.ClearActivity(jobs);
+        progress.PartDone();
+    }
+    for (auto& w : workers) w.join();
+    const double wallMs = MillisSince(wallStart);
+    progress.Finish();
+
+    const size_t failed = PrintBuildReport(builds, opt.meshReport);
+    std::cout << "Built " << count << " parts in " << static_cast<long long>(wallMs) << " ms (" << jobs
+              << (jobs == 1 ? " job" : " jobs") << ")\n";
+    LOG(INFO) << ccad::GetKernelStats();
+    return failed == 0;
+}
 
-        if (!m_Engine->RunFile(luaFile)) {
-            return;
+void Controller::ExportPart(const Part& part, PartBuild& b, const fs::path& outDir, PartCache* cache,
+                            const ccad::io::StlOptions& stlOpt, bool meshReport) const {
+    if (!b.shape) {
+        std::cerr << "Canot get shape from " << part.source << std::endl;
+        return;
+    }
+    const fs::path stlFile = outDir / (b.stem + ".stl");
+    const fs::path stepFile = outDir / (b.stem + ".step");
+
+    auto start = Clock::now();
+    const auto meshParams = MeshParamsFor(part);
+    const auto variant = PartCache::MeshVariant(meshParams);
+    std::shared_ptr<const ccad::geom::TriMesh> mesh;
+    if (cache) {
+        if (auto cached = cache->LoadMesh(b.key, variant)) {
+            mesh = std::make_shared<const ccad::geom::TriMesh>(std::move(*cached));
         }
+    }
+    if (!mesh) {
+        mesh = ccad::geom::TriangulateShared(*b.shape, meshParams);
+        if (cache) cache->StoreMesh(b.key, variant, *mesh);
+    }
+    b.triangles = mesh->indices.size() / 3;
+    b.deflection = ccad::geom::ResolveParams(*b.shape, meshParams).linearDeflection;
+    if (meshReport) {
+        const auto legacyParams = ccad::geom::QualityPreset(ccad::geom::MeshQuality::Legacy);
+        b.legacy = ccad::geom::TriangulateShared(*b.shape, legacyParams)->indices.size() / 3;
+    }
+    b.meshMs = MillisSince(start);
 
-        auto emitted = m_Engine->GetEmitted();
-        if (!emitted) {
-            std::cerr << "Canot get shape from " << luaFile << std::endl;
-            return;
+    start = Clock::now();
+    if (ccad::io::WriteSTL(*mesh, stlFile.string(), stlOpt)) {
+        LOG(INFO) << "Wrote STL: " << stlFile.string();
+    } else {
+        LOG(ERROR) << "Failed to write STL: " << stlFile.string();
+    }
+    ccad::io::SaveSTEP(*b.shape, stepFile.string());
+    b.exportMs = MillisSince(start);
+    b.exported = true;
+}
+
+size_t Controller::PrintBuildReport(const std::vector<PartBuild>& builds, bool meshReport) {
+    size_t nameWidth = 4;
+    for (const auto& b : builds) nameWidth = std::max(nameWidth, b.stem.size());
+
+    // Project order, independent of which worker finished first
+    std::cout << std::left << std::setw(static_cast<int>(nameWidth)) << "Part" << std::right << std::setw(11)
+              << "Triangles" << std::setw(14) << "Deflection";
+    if (meshReport) std::cout << std::setw(11) << "Legacy";
+    std::cout << std::setw(10) << "Eval" << std::setw(10) << "Mesh" << std::setw(10) << "Export" << "\n";
+
+    size_t totalTriangles = 0, totalLegacy = 0, failed = 0;
+    const auto precision = std::cout.precision();
+    std::cout << std::fixed;
+    for (const auto& b : builds) {
+        std::cout << std::left << std::setw(static_cast<int>(nameWidth)) << b.stem << std::right;
+        if (!b.exported) {
+            std::cout << "  failed\n";
+            ++failed;
+            continue;
         }
-        const auto stem = fs::path(luaFile).stem().string();
-        const fs::path stlFile = outDir / (stem + ".stl");
-        const fs::path stepFile = outDir / (stem + ".step");
-        ccad::io::SaveSTL(emitted.value(), stlFile.string(), ccad::lua::GetTriangulationParameters());
-        ccad::io::SaveSTEP(emitted.value(), stepFile.string());
+        totalTriangles += b.triangles;
+        totalLegacy += b.legacy;
+        std::cout << std::setw(11) << b.triangles << std::setw(11) << std::setprecision(3) << b.deflection << " mm";
+        if (meshReport) std::cout << std::setw(11) << b.legacy;
+        std::cout << std::setprecision(0) << std::setw(7) << b.evalMs << " ms" << std::setw(7) << b.meshMs << " ms"
+                  << std::setw(7) << b.exportMs << " ms" << (b.fromCache ? "  (cached)" : "") << "\n";
     }
+    std::cout << std::defaultfloat << std::setprecision(precision);
+
+    std::cout << "Total: " << totalTriangles << " triangles";
+    if (meshReport) std::cout << " (legacy " << totalLegacy << ")";
+    std::cout << "\n";
+    if (failed) std::cerr << failed << " of " << builds.size() << " parts failed\n";
+    return failed;
 }
+
 void Controller::ViewProject() {
     if (!m_ProjectLoaded) {
         throw std::runtime_error("No project is loaded!");
@@ -151,6 +328,8 @@ void Controller::ViewProject() {
     ProjectPanel panel(m_Project);
     panel.SetOnSave([this](const Project& p) { p.Save(fs::path(m_ProjectDir) / PROJECT_FILENAME, /*pretty*/ true); });
 
+    panel.SetBuildStatus(
+        [this](const std::string& partId) { return m_LiveBuilder && m_LiveBuilder->IsBuilding(partId); });
     m_PureController.SetRightDockPanel([&panel]() { panel.Draw(); });
 
     m_PureController.SetMouseMoveHandler([this](double x, double y) {
@@ -210,17 +389,17 @@ void Controller::ViewProject() {
     m_Picker->SetScene(m_Scene.get());
     m_Measure.SetReporter([this](const std::string& s) { this->m_PureController.SetStatus(s); });
 
+    // Scripts run on builder threads, the render loop only uploads finished meshes
+    const size_t builders = std::clamp<size_t>(ccad::WorkerCount() / 2, 1, 4);
+    m_LiveBuilder = std::make_unique<LiveBuilder>(builders, [this]() { return CreateEngine(); });
+    m_FitCameraPending = true;
+
     RebuildAllParts();
     SetupWatchers();
 
-    // Set camera only upon first load
-    PureBounds bounds;
-    if (m_Scene->ComputeBounds(bounds)) {
-        m_PureController.Camera()->FitToBounds(bounds, 1.12f);
-    }
-
     while (!m_PureController.ShouldClose()) {
         PollWatchers();
+        ApplyFinishedBuilds();
 
         m_PureController.BeginFrame();
 
@@ -240,6 +419,7 @@ void Controller::ViewProject() {
         m_PureController.EndFrame();
     }
 
+    m_LiveBuilder.reset();  // waits for running scripts
     m_PureController.Shutdown();
 }
 
@@ -294,55 +474,160 @@ void Controller::PollWatchers() {
     }
 }
 
-void Controller::ClearScene() {
-    if (m_Scene) m_Scene->Clear();
+void Controller::SetMeshQuality(ccad::geom::MeshQuality quality) {
+    m_MeshQuality = quality;
 }
 
-void Controller::AddPartToScene(const Part& part) {
-    fs::path src = fs::path(m_ProjectDir) / part.source;
-    auto luaFile = std::filesystem::weakly_canonical(src);
+ccad::geom::TriangulationParams Controller::MeshParamsFor(const Part& part) const {
+    auto quality = m_MeshQuality;
+    if (!part.mesh.quality.empty() && !ccad::geom::ParseMeshQuality(part.mesh.quality, quality)) {
+        LOG(WARN) << "Unknown mesh quality '" << part.mesh.quality << "' for part " << part.id;
+    }
 
-    std::optional<ccad::Shape> emitted;
-    try {
-        if (!m_Engine->RunFile(luaFile)) {
-            LOG(ERROR) << "Problem with file " << luaFile;
-            return;
+    auto p = ccad::geom::QualityPreset(quality);
+    if (part.mesh.relative) p.relativeDeflection = *part.mesh.relative;
+    if (part.mesh.deflection) {
+        p.linearDeflection = *part.mesh.deflection;
+        p.relativeDeflection = 0.0;
+    }
+    if (part.mesh.angle) p.angularDeflectionDeg = *part.mesh.angle;
+    return p;
+}
+
+std::optional<ccad::Shape> Controller::EvaluatePart(ccad::lua::LuaEngine& engine, const fs::path& luaFile,
+                                                    const ParamsMap& params, PartCache* cache, std::string& key,
+                                                    bool* fromCache) const {
+    if (cache) {
+        if (auto cached = cache->LoadShape(key)) {
+            LOG(INFO) << "Loaded " << luaFile.filename() << " from the part cache";
+            if (fromCache) *fromCache = true;
+            return cached;
         }
+    }
+
+    // The key hashes the script text as it was run, read once up front; the required libraries are added after
+    const auto source = cache ? PartCache::ReadScript(luaFile) : std::nullopt;
+    if (!engine.RunFile(luaFile.string())) return std::nullopt;
+    auto emitted = engine.GetEmitted();
+    if (!emitted || !cache) return emitted;
+
+    key.clear();  // nothing is stored (shape or mesh) unless the result belongs to the script as run
+    if (!source || ccad::IsCancelled()) return emitted;
+    if (PartCache::ReadScript(luaFile) != source) {
+        LOG(INFO) << luaFile.filename() << " changed during the run, result not cached";
+        return emitted;
+    }
+    const auto deps = engine.RequiredModuleFiles();
+    cache->RecordDependencies(luaFile, deps);
+    key = cache->KeyForSource(*source, deps, params);
+    cache->StoreShape(key, *emitted);
+    return emitted;
+}
+
+void Controller::QueuePartBuild(const Part& part) {
+    const auto luaFile = std::filesystem::weakly_canonical(fs::path(m_ProjectDir) / part.source);
+
+    // Runs on a builder thread: works on copies, never on m_Project which the render thread may reload
+    m_LiveBuilder->Submit(part.id, [this, part, luaFile, params = m_Project.params](
+                                       ccad::lua::LuaEngine& engine, const ccad::CancelToken& cancel) {
+        return BuildLivePart(engine, part, luaFile, params, cancel);
+    });
+}
 
-        emitted = m_Engine->GetEmitted();
+LivePartMesh Controller::BuildLivePart(ccad::lua::LuaEngine& engine, const Part& part, const fs::path& luaFile,
+                                       const ParamsMap& params, const ccad::CancelToken& cancel) const {
+    LivePartMesh out;
+
+    // The viewer shades smoothly within creases, so welded vertices halve the upload
+    auto meshParams = MeshParamsFor(part);
+    meshParams.weld = true;
+    const auto variant = PartCache::MeshVariant(meshParams, &part.transform);
+    std::string key = m_PartCache ? m_PartCache->KeyFor(luaFile, params) : std::string();
+
+    ccad::geom::TriMesh tri;
+    if (auto cached = m_PartCache ? m_PartCache->LoadMesh(key, variant) : std::nullopt) {
+        tri = std::move(*cached);
+    } else {
+        ApplyProjectParamsToLua(engine.Lua(), params);
+        engine.SetTriangulationParameters(MeshParamsFor(part));
+        auto emitted = EvaluatePart(engine, luaFile, params, m_PartCache.get(), key);
         if (!emitted) {
             LOG(ERROR) << "Cannot get shape from " << luaFile;
-            return;
+            return out;
         }
-    } catch (std::exception& e) {
-        LOG(ERROR) << "Error during processing lua file: " << e.what();
-        return;
-    }
+        if (cancel.IsCancelled()) return out;
 
-    // Apply transform from project.json
-    auto shaped = ApplyProjectTransform(*emitted, part.transform);
+        // Apply transform from project.json
+        auto shaped = ApplyProjectTransform(*emitted, part.transform);
+        tri = ccad::geom::Triangulate(shaped, meshParams);
+        if (cancel.IsCancelled()) return out;
+        if (m_PartCache) m_PartCache->StoreMesh(key, variant, tri);  // empty key: not cacheable
+    }
+    if (cancel.IsCancelled()) return out;
+    LOG(INFO) << "Part " << part.id << ": " << tri.indices.size() / 3 << " triangles";
+
+    out.hasNormals = tri.normals.size() == tri.positions.size();
+    out.vertices.reserve(tri.positions.size());
+    for (size_t i = 0; i < tri.positions.size(); ++i) {
+        const auto& v = tri.positions[i];
+        const glm::vec3 n =
+            out.hasNormals ? glm::vec3(tri.normals[i].x, tri.normals[i].y, tri.normals[i].z) : glm::vec3(0);
+        out.vertices.push_back({glm::vec3(v.x, v.y, v.z), n});
+    }
+    out.indices = std::move(tri.indices);
+    out.ok = true;
+    return out;
+}
 
-    auto color = m_Project.materials[part.material].color;
-    if (color.empty()) color = "#cccccc";
+void Controller::ApplyFinishedBuilds() {
+    for (auto& built : m_LiveBuilder->TakeFinished()) {
+        const Part* part = nullptr;
+        for (const auto& pr : m_Project.parts) {
+            if (pr.id == built.partId) part = &pr;
+        }
+        if (!part || !part->visible) continue;  // removed or hidden while it was building
 
-    ccad::geom::TriMesh tri = ccad::geom::Triangulate(shaped, ccad::lua::GetTriangulationParameters());
+        if (!built.ok) {
+            // The previous geometry stays in the scene
+            m_PureController.SetStatus("Part " + part->id + " rebuild failed.");
+            continue;
+        }
 
-    std::vector<PureVertex> vertices;
+        auto color = m_Project.materials[part->material].color;
+        if (color.empty()) color = "#cccccc";
 
-    for (const auto& v : tri.positions) {
-        vertices.push_back({glm::vec3(v.x, v.y, v.z), glm::vec3(0.0, 0.0, 0.0)});  // no normals!
+        auto mesh = std::make_shared<PureMesh>();
+        mesh->Upload(built.vertices, built.indices, /*recalculateNormals*/ !built.hasNormals);
+        m_Scene->RemovePartById(part->id);
+        m_Scene->AddPart(part->id, mesh, glm::mat4(1.0f), ParseHexColor(color));
+        m_PureController.SetStatus("Part " + part->id + " rebuilt.");
     }
 
-    auto mesh = std::make_shared<PureMesh>();
-    mesh->Upload(vertices, tri.indices);
-    m_Scene->AddPart(part.id, mesh, glm::mat4(1.0f), ParseHexColor(color));
+    // Set camera only upon first load
+    if (m_FitCameraPending && m_LiveBuilder->Idle()) {
+        m_FitCameraPending = false;
+        PureBounds bounds;
+        if (m_Scene->ComputeBounds(bounds)) {
+            m_PureController.Camera()->FitToBounds(bounds, 1.12f);
+        }
+    }
 }
 
 void Controller::RebuildAllParts() {
-    ClearScene();
+    // Parts which are gone or hidden leave the scene now, all others are replaced once rebuilt
+    std::unordered_set<std::string> visible;
+    for (const auto& part : m_Project.parts) {
+        if (part.visible) visible.insert(part.id);
+    }
+    std::vector<std::string> stale;
+    for (const auto& scenePart : m_Scene->Parts()) {
+        if (!visible.count(scenePart.id)) stale.push_back(scenePart.id);
+    }
+    for (const auto& id : stale) m_Scene->RemovePartById(id);
+
     for (const auto& part : m_Project.parts) {
         if (part.visible) {
-            AddPartToScene(part);
+            QueuePartBuild(part);
         }
     }
 }
@@ -357,7 +642,6 @@ void Controller::RebuildPartByPath(const std::string& luaPath) {
     }
     const std::string& partId = it->second;
 
-    m_Scene->RemovePartById(partId);
     const Part* p = nullptr;
     for (const auto& pr : m_Project.parts)
         if (pr.id == partId) {
@@ -365,7 +649,7 @@ void Controller::RebuildPartByPath(const std::string& luaPath) {
             break;
         }
     if (!p) return;
-    AddPartToScene(*p);
+    QueuePartBuild(*p);
 }
 
 void Controller::CreateBom() {
@@ -396,7 +680,7 @@ void Controller::CreateBom() {
                 std::cerr << "Warning: could not clear BOM for part\n";
             }
 
-            ApplyProjectParamsToLua(m_Engine->Lua(), m_Project);
+            ApplyProjectParamsToLua(m_Engine->Lua(), m_Project.params);
             if (!m_Engine->RunFile(luaFile.string())) {
                 return;
             }
@@ -420,7 +704,11 @@ void Controller::CreateBom() {
 }
 
 void Controller::SetupEngine() {
-    m_Engine = std::make_shared<ccad::lua::LuaEngine>();
+    m_Engine = CreateEngine();
+}
+
+std::shared_ptr<ccad::lua::LuaEngine> Controller::CreateEngine() const {
+    auto engine = std::make_shared<ccad::lua::LuaEngine>();
 
     // Standard search paths
     std::vector<std::string> paths = {"./lib/?.lua", "./lib/?/init.lua", "./vendor/?.lua", "./vendor/?/init.lua"};
@@ -440,21 +728,21 @@ void Controller::SetupEngine() {
 
     // CLI options
     paths.insert(paths.end(), m_LuaPaths.begin(), m_LuaPaths.end());
-    m_Engine->SetLibraryPaths(paths);
+    engine->SetLibraryPaths(paths);
 
     std::string err;
-    if (!m_Engine->Initialize(&err)) {
+    if (!engine->Initialize(&err)) {
         throw std::runtime_error(std::string("CoreEngine init failed: ") + err);
     }
+    return engine;
 }
 
 void Controller::OnProjectChanged() {
     try {
         m_PureController.SetStatus("Project changed. Reloading...");
-        m_Scene->Clear();
         m_Project.Load(fs::path(m_ProjectDir) / PROJECT_FILENAME);
 
-        ApplyProjectParamsToLua(m_Engine->Lua(), m_Project);
+        ApplyProjectParamsToLua(m_Engine->Lua(), m_Project.params);
         ResetLuaWatchers();
         RebuildAllParts();
 
@@ -469,7 +757,7 @@ void Controller::OnLuaChanged(const std::string& luaPath) {
     try {
         // only rebuild affected part
         RebuildPartByPath(luaPath);
-        m_PureController.SetStatus("Part rebuilt.");
+        m_PureController.SetStatus("Rebuilding part...");
     } catch (const std::exception& e) {
         std::cerr << "Part rebuild failed: " << e.what() << " (" << luaPath << ")\n";
         m_PureController.SetStatus("Part rebuild failed.");
@@ -0,0 +1,104 @@
+#include "LiveBuilder.hpp"
+
+#include <algorithm>
+#include <ccad/base/Execution.hpp>
+#include <ccad/base/Logger.hpp>
+
+LiveBuilder::LiveBuilder(size_t workers, EngineFactory factory) : m_Factory(std::move(factory)) {
+    workers = std::max<size_t>(1, workers);
+    for (size_t i = 0; i < workers; ++i) m_Workers.emplace_back([this]() { WorkerLoop(); });
+}
+
+LiveBuilder::~LiveBuilder() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+        m_Queue.clear();
+        for (auto& kv : m_Latest) kv.second.cancel.Cancel();
+    }
+    m_Cv.notify_all();
+    for (auto& w : m_Workers) w.join();
+}
+
+void LiveBuilder::Submit(const std::string& partId, Job job) {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto& latest = m_Latest[partId];
+        latest.cancel.Cancel();
+        m_Queue.erase(std::remove_if(m_Queue.begin(), m_Queue.end(), [&](const Task& t) { return t.partId == partId; }),
+                      m_Queue.end());
+
+        latest.generation = ++m_Generation;
+        latest.cancel = ccad::CancelToken();
+        latest.done = false;
+        m_Queue.push_back({partId, latest.generation, std::move(job), latest.cancel});
+    }
+    m_Cv.notify_one();
+}
+
+std::vector<LivePartMesh> LiveBuilder::TakeFinished() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::vector<LivePartMesh> out;
+    out.swap(m_Finished);
+    return out;
+}
+
+bool LiveBuilder::IsBuilding(const std::string& partId) const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Latest.find(partId);
+    return it != m_Latest.end() && !it->second.done;
+}
+
+bool LiveBuilder::Idle() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    for (const auto& kv : m_Latest) {
+        if (!kv.second.done) return false;
+    }
+    return true;
+}
+
+std::deque<LiveBuilder::Task>::iterator LiveBuilder::NextTaskLocked() {
+    return std::find_if(m_Queue.begin(), m_Queue.end(), [this](const Task& t) { return !m_Latest[t.partId].running; });
+}
+
+void LiveBuilder::WorkerLoop() {
+    std::shared_ptr<ccad::lua::LuaEngine> engine;
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            auto next = m_Queue.end();
+            m_Cv.wait(lock, [&]() { return m_Stop || (next = NextTaskLocked()) != m_Queue.end(); });
+            if (m_Stop) return;
+            task = std::move(*next);
+            m_Queue.erase(next);
+            m_Latest[task.partId].running = true;
+        }
+
+        LivePartMesh result;
+        try {
+            // Created on the worker, a Lua state is only ever used by the thread owning it
+            if (!engine) engine = m_Factory();
+            ccad::WorkerScope scope;
+            ccad::OperationContext context(task.cancel);
+            if (!task.cancel.IsCancelled()) result = task.job(*engine, task.cancel);
+        } catch (const std::exception& e) {
+            if (!task.cancel.IsCancelled()) LOG(ERROR) << "Build of part " << task.partId << " failed: " << e.what();
+        } catch (...) {
+            // OCCT's Standard_Failure from meshing or transforms: must not terminate the viewer
+            if (!task.cancel.IsCancelled()) LOG(ERROR) << "Build of part " << task.partId << " failed";
+        }
+        result.partId = task.partId;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            auto& latest = m_Latest[task.partId];
+            latest.running = false;
+            if (latest.generation == task.generation) {
+                latest.done = true;
+                if (!task.cancel.IsCancelled()) m_Finished.push_back(std::move(result));
+            }  // else superseded: the newer build is queued and may start now
+        }
+        m_Cv.notify_all();
+    }
+}
@@ -0,0 +1,249 @@
+#include "PartCache.hpp"
+
+#include <algorithm>
+#include <ccad/base/Logger.hpp>
+#include <ccad/io/Brep.hpp>
+#include <ccad/version.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace fs = std::filesystem;
+using ccad::geom::TriMesh;
+
+namespace {
+
+constexpr char kMeshMagic[8] = {'C', 'C', 'A', 'D', 'M', 'S', 'H', '1'};
+
+/// FNV-1a over the bytes of everything fed in; only used for cache file names.
+class KeyHasher {
+   public:
+    void Add(const void* data, size_t n) {
+        const auto* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < n; ++i) {
+            m_Hash ^= p[i];
+            m_Hash *= 0x100000001b3ull;
+        }
+    }
+    void Add(const std::string& s) {
+        const uint64_t n = s.size();
+        Add(&n, sizeof(n));
+        Add(s.data(), s.size());
+    }
+    void Add(double v) {
+        Add(&v, sizeof(v));
+    }
+    std::string Hex() const {
+        char buf[17];
+        std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(m_Hash));
+        return buf;
+    }
+
+   private:
+    uint64_t m_Hash = 0xcbf29ce484222325ull;
+};
+
+bool ReadFile(const fs::path& p, std::string& out) {
+    std::ifstream in(p, std::ios::binary);
+    if (!in) return false;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    out = ss.str();
+    return true;
+}
+
+/// Write to a per-thread temporary file first, so concurrent readers never see a partial entry.
+template <typename WriteFn>
+bool WriteAtomically(const fs::path& p, WriteFn&& write) {
+    const auto thread = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    const fs::path tmp = p.string() + "." + std::to_string(thread) + ".tmp";
+    if (!write(tmp)) {
+        std::error_code ec;
+        fs::remove(tmp, ec);
+        return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp, p, ec);
+    return !ec;
+}
+
+template <typename T>
+void WriteVector(std::ofstream& out, const std::vector<T>& v) {
+    const uint64_t n = v.size();
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    out.write(reinterpret_cast<const char*>(v.data()), static_cast<std::streamsize>(n * sizeof(T)));
+}
+
+template <typename T>
+bool ReadVector(std::ifstream& in, std::vector<T>& v, uintmax_t remaining) {
+    uint64_t n = 0;
+    if (!in.read(reinterpret_cast<char*>(&n), sizeof(n)) || n > remaining / sizeof(T)) return false;
+    v.resize(n);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(v.data()), static_cast<std::streamsize>(n * sizeof(T))));
+}
+
+}  // namespace
+
+PartCache::PartCache(fs::path dir, uintmax_t budgetBytes) : m_Dir(std::move(dir)), m_Budget(budgetBytes) {
+    std::error_code ec;
+    fs::create_directories(m_Dir / "deps", ec);
+    if (ec) LOG(WARN) << "Cannot create part cache " << m_Dir << ": " << ec.message();
+}
+
+fs::path PartCache::DepsFile(const fs::path& script) const {
+    KeyHasher h;
+    h.Add(script.string());
+    return m_Dir / "deps" / (h.Hex() + ".deps");
+}
+
+std::string PartCache::KeyFor(const fs::path& script, const ParamsMap& params) const {
+    const auto source = ReadScript(script);
+    if (!source) return {};
+
+    // Library files required on the last evaluation; unchanged script + libraries require the same set
+    std::vector<std::string> deps;
+    std::ifstream in(DepsFile(script));
+    for (std::string dep; std::getline(in, dep);) deps.push_back(dep);
+    return KeyForSource(*source, deps, params);
+}
+
+std::string PartCache::KeyForSource(const std::string& source, const std::vector<std::string>& deps,
+                                    const ParamsMap& params) const {
+    KeyHasher h;
+    h.Add(std::string(CODECAD_VERSION_STRING));
+    h.Add(static_cast<double>(CODECAD_BUILD_NUMBER));
+    h.Add(source);
+
+    std::string content;
+    for (const auto& dep : deps) {
+        h.Add(dep);
+        h.Add(ReadFile(dep, content) ? content : std::string());
+    }
+
+    for (const auto& [name, v] : params) {
+        h.Add(name);
+        h.Add(static_cast<double>(static_cast<int>(v.type)));
+        h.Add(v.number);
+        h.Add(static_cast<double>(v.boolean));
+        h.Add(v.string);
+    }
+    return h.Hex();
+}
+
+std::optional<std::string> PartCache::ReadScript(const fs::path& script) {
+    std::string content;
+    if (!ReadFile(script, content)) return std::nullopt;
+    return content;
+}
+
+void PartCache::RecordDependencies(const fs::path& script, const std::vector<std::string>& files) {
+    WriteAtomically(DepsFile(script), [&](const fs::path& tmp) {
+        std::ofstream out(tmp);
+        for (const auto& f : files) out << f << "\n";
+        return static_cast<bool>(out);
+    });
+}
+
+std::optional<ccad::Shape> PartCache::LoadShape(const std::string& key) {
+    const fs::path p = m_Dir / (key + ".brep");
+    std::error_code ec;
+    if (key.empty() || !fs::exists(p, ec)) return std::nullopt;
+
+    auto shape = ccad::io::LoadBREP(p.string());
+    if (shape) Touch(p);
+    return shape;
+}
+
+void PartCache::StoreShape(const std::string& key, const ccad::Shape& shape) {
+    if (key.empty()) return;
+    WriteAtomically(m_Dir / (key + ".brep"),
+                    [&](const fs::path& tmp) { return ccad::io::SaveBREP(shape, tmp.string()); });
+    Evict();
+}
+
+std::optional<TriMesh> PartCache::LoadMesh(const std::string& key, const std::string& variant) {
+    const fs::path p = m_Dir / (key + "-" + variant + ".mesh");
+    std::error_code ec;
+    const uintmax_t size = key.empty() ? 0 : fs::file_size(p, ec);
+    if (ec || size == 0) return std::nullopt;
+
+    std::ifstream in(p, std::ios::binary);
+    char magic[sizeof(kMeshMagic)];
+    TriMesh mesh;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMeshMagic, sizeof(magic)) != 0 ||
+        !ReadVector(in, mesh.positions, size) || !ReadVector(in, mesh.normals, size) ||
+        !ReadVector(in, mesh.indices, size)) {
+        LOG(WARN) << "Ignoring corrupt mesh cache entry " << p;
+        return std::nullopt;
+    }
+    Touch(p);
+    return mesh;
+}
+
+void PartCache::StoreMesh(const std::string& key, const std::string& variant, const TriMesh& mesh) {
+    static_assert(sizeof(ccad::Vec3) == 3 * sizeof(double), "Vec3 is written as three doubles");
+    if (key.empty()) return;
+    WriteAtomically(m_Dir / (key + "-" + variant + ".mesh"), [&](const fs::path& tmp) {
+        std::ofstream out(tmp, std::ios::binary);
+        out.write(kMeshMagic, sizeof(kMeshMagic));
+        WriteVector(out, mesh.positions);
+        WriteVector(out, mesh.normals);
+        WriteVector(out, mesh.indices);
+        return static_cast<bool>(out);
+    });
+    Evict();
+}
+
+std::string PartCache::MeshVariant(const ccad::geom::TriangulationParams& p, const PartTransform* tr) {
+    KeyHasher h;
+    for (double v : {p.linearDeflection, p.angularDeflectionDeg, p.relativeDeflection, p.minDeflection,
+                     p.maxDeflection, p.creaseAngleDeg}) {
+        h.Add(v);
+    }
+    h.Add(static_cast<double>(p.curvatureAware));
+    h.Add(static_cast<double>(p.weld));
+    if (tr) {
+        for (int i = 0; i < 3; ++i) {
+            h.Add(static_cast<double>(tr->translate[i]));
+            h.Add(static_cast<double>(tr->rotate[i]));
+        }
+        h.Add(tr->scale);
+    }
+    return h.Hex();
+}
+
+void PartCache::Touch(const fs::path& p) const {
+    // Write times order the eviction, so a hit keeps the entry alive
+    std::error_code ec;
+    fs::last_write_time(p, fs::file_time_type::clock::now(), ec);
+}
+
+void PartCache::Evict() const {
+    struct Entry {
+        fs::path path;
+        fs::file_time_type time;
+        uintmax_t size;
+    };
+    std::vector<Entry> entries;
+    uintmax_t total = 0;
+
+    std::error_code ec;
+    for (const auto& de : fs::directory_iterator(m_Dir, ec)) {
+        if (!de.is_regular_file(ec) || de.path().extension() == ".tmp") continue;  // entries being written
+        Entry e{de.path(), de.last_write_time(ec), de.file_size(ec)};
+        if (ec) continue;
+        total += e.size;
+        entries.push_back(std::move(e));
+    }
+    if (total <= m_Budget) return;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    for (const auto& e : entries) {
+        if (total <= m_Budget) break;
+        if (fs::remove(e.path, ec)) total -= e.size;
+    }
+}
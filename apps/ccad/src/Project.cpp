@@ -75,6 +75,30 @@ static PartTransform getTransform(const json& jt) {
     return t;
 }
 
+static std::optional<double> getOptDouble(const json& j, const char* key) {
+    if (j.contains(key) && j[key].is_number()) return j[key].get<double>();
+    return std::nullopt;
+}
+
+static PartMesh getMesh(const json& jm) {
+    PartMesh m;
+    if (!jm.is_object()) return m;
+    m.quality = jm.value("quality", "");
+    m.deflection = getOptDouble(jm, "deflection");
+    m.relative = getOptDouble(jm, "relative");
+    m.angle = getOptDouble(jm, "angle");
+    return m;
+}
+
+static json j_mesh(const PartMesh& m) {
+    json jm = json::object();
+    if (!m.quality.empty()) jm["quality"] = m.quality;
+    if (m.deflection) jm["deflection"] = *m.deflection;
+    if (m.relative) jm["relative"] = *m.relative;
+    if (m.angle) jm["angle"] = *m.angle;
+    return jm;
+}
+
 void Project::Load(const std::string& path) {
     materials.clear();
     parts.clear();
@@ -128,6 +152,7 @@ void Project::Load(const std::string& path) {
             pr.material = jp.value("material", "");
             pr.transform = getTransform(jp.value("transform", json::object()));
             pr.visible = getBoolSafe(jp, "visible", true);
+            pr.mesh = getMesh(jp.value("mesh", json::object()));
             parts.emplace_back(std::move(pr));
         }
     }
@@ -208,6 +233,7 @@ bool Project::Save(const std::string& path, bool pretty) const {
             if (!pr.material.empty()) jp["material"] = pr.material;
             jp["transform"] = j_transform(pr.transform);
             jp["visible"] = pr.visible;
+            if (pr.mesh.IsSet()) jp["mesh"] = j_mesh(pr.mesh);
             arr.push_back(std::move(jp));
         }
         j["parts"] = std::move(arr);
@@ -285,6 +311,13 @@ void Project::Print() {
             oss << "        rotate    = (" << pr.transform.rotate.x << ", " << pr.transform.rotate.y << ", "
                 << pr.transform.rotate.z << ")\n";
             oss << "        scale     = " << pr.transform.scale << "\n";
+            if (pr.mesh.IsSet()) {
+                oss << "      mesh:\n";
+                if (!pr.mesh.quality.empty()) oss << "        quality    = " << pr.mesh.quality << "\n";
+                if (pr.mesh.deflection) oss << "        deflection = " << *pr.mesh.deflection << "\n";
+                if (pr.mesh.relative) oss << "        relative   = " << *pr.mesh.relative << "\n";
+                if (pr.mesh.angle) oss << "        angle      = " << *pr.mesh.angle << "\n";
+            }
         }
     }
 
@@ -7,6 +7,9 @@ ProjectPanel::ProjectPanel(Project& p) : m_Project(p) {
 void ProjectPanel::SetOnSave(SaveCallback cb) {
     m_OnSave = std::move(cb);
 }
+void ProjectPanel::SetBuildStatus(BuildStatusCallback cb) {
+    m_IsBuilding = std::move(cb);
+}
 
 void ProjectPanel::Draw() {
     bool changed = false;
@@ -51,6 +54,10 @@ bool ProjectPanel::DrawParts() {
             part.visible = v;
             c = true;
         }
+        if (m_IsBuilding && m_IsBuilding(part.id)) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("rebuilding...");
+        }
         ImGui::PopID();
     }
     return c;
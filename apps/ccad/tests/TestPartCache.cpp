@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+#include "PartCache.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void WriteText(const fs::path& p, const std::string& text) {
+    std::ofstream(p) << text;
+}
+
+/// A part script with one library dependency in a scratch directory.
+class TestPartCache : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        m_Dir = fs::temp_directory_path() / "ccad_part_cache";
+        fs::remove_all(m_Dir);
+        fs::create_directories(m_Dir);
+        m_Script = m_Dir / "part.lua";
+        m_Library = m_Dir / "size.lua";
+        WriteText(m_Script, "emit(box(require('size'), 1, 1))\n");
+        WriteText(m_Library, "return 10\n");
+        m_Cache = std::make_unique<PartCache>(m_Dir / "cache");
+        m_Cache->RecordDependencies(m_Script, {m_Library.string()});
+        m_Params["width"] = ParamValue::FromNumber(10);
+    }
+    void TearDown() override {
+        m_Cache.reset();
+        fs::remove_all(m_Dir);
+    }
+
+    fs::path m_Dir, m_Script, m_Library;
+    std::unique_ptr<PartCache> m_Cache;
+    ParamsMap m_Params;
+};
+
+}  // namespace
+
+TEST_F(TestPartCache, HitForUnchangedInputs) {
+    const auto key = m_Cache->KeyFor(m_Script, m_Params);
+    ASSERT_FALSE(key.empty());
+    EXPECT_EQ(m_Cache->KeyFor(m_Script, m_Params), key);
+
+    ccad::geom::TriMesh mesh;
+    mesh.positions = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    mesh.indices = {0, 1, 2};
+    m_Cache->StoreMesh(key, "v", mesh);
+    auto loaded = m_Cache->LoadMesh(m_Cache->KeyFor(m_Script, m_Params), "v");
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->positions.size(), 3u);
+    EXPECT_EQ(loaded->indices, mesh.indices);
+    EXPECT_FALSE(m_Cache->LoadMesh(key, "other").has_value());  // another tessellation variant
+}
+
+TEST_F(TestPartCache, MissAfterScriptEdit) {
+    const auto key = m_Cache->KeyFor(m_Script, m_Params);
+    WriteText(m_Script, "emit(box(require('size'), 2, 1))\n");
+    EXPECT_NE(m_Cache->KeyFor(m_Script, m_Params), key);
+}
+
+TEST_F(TestPartCache, MissAfterDependencyEdit) {
+    const auto key = m_Cache->KeyFor(m_Script, m_Params);
+    WriteText(m_Library, "return 20\n");
+    EXPECT_NE(m_Cache->KeyFor(m_Script, m_Params), key);
+}
+
+TEST_F(TestPartCache, MissAfterParamsChange) {
+    const auto key = m_Cache->KeyFor(m_Script, m_Params);
+    m_Params["width"] = ParamValue::FromNumber(11);
+    EXPECT_NE(m_Cache->KeyFor(m_Script, m_Params), key);
+    m_Params["width"] = ParamValue::FromString("10");
+    EXPECT_NE(m_Cache->KeyFor(m_Script, m_Params), key);  // same text, other type
+}
+
+TEST_F(TestPartCache, KeyForSourceUsesTheTextAsRun) {
+    const auto source = PartCache::ReadScript(m_Script);
+    ASSERT_TRUE(source.has_value());
+    const auto key = m_Cache->KeyForSource(*source, {m_Library.string()}, m_Params);
+    EXPECT_EQ(m_Cache->KeyFor(m_Script, m_Params), key);
+
+    // Saved while the run was in progress: the edited file must not map to the old result
+    WriteText(m_Script, "emit(box(require('size'), 3, 1))\n");
+    EXPECT_NE(m_Cache->KeyFor(m_Script, m_Params), key);
+    EXPECT_EQ(m_Cache->KeyForSource(*source, {m_Library.string()}, m_Params), key);
+}
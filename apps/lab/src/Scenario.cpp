@@ -34,12 +34,16 @@ void Scenario::SaveSTL(const std::string& fileName) {
 std::shared_ptr<PureMesh> Scenario::ShapeToMesh(const Shape& shape) {
     TriMesh tri = Triangulate(shape, GetTriangulateParams());
 
+    const bool hasNormals = tri.normals.size() == tri.positions.size();
     std::vector<PureVertex> verts;
     verts.reserve(tri.positions.size());
-    for (auto& p : tri.positions) {
-        verts.push_back({glm::vec3((float)p.x, (float)p.y, (float)p.z), glm::vec3(0, 0, 0)});
+    for (size_t i = 0; i < tri.positions.size(); ++i) {
+        const auto& p = tri.positions[i];
+        glm::vec3 n(0, 0, 0);
+        if (hasNormals) n = glm::vec3((float)tri.normals[i].x, (float)tri.normals[i].y, (float)tri.normals[i].z);
+        verts.push_back({glm::vec3((float)p.x, (float)p.y, (float)p.z), n});
     }
     auto mesh = std::make_shared<PureMesh>();
-    mesh->Upload(verts, tri.indices);
+    mesh->Upload(verts, tri.indices, /*recalculateNormals*/ !hasNormals);
     return mesh;
 }
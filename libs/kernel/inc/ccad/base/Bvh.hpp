@@ -0,0 +1,59 @@
+#pragma once
+
+#include <ccad/base/Math.hpp>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ccad {
+
+/**
+ * @brief Static bounding volume hierarchy over item boxes.
+ *
+ * Built once from one axis-aligned box per item (item i has box i); queries return the
+ * indices of items whose box matches, in O(log n + k). Callers refine the candidates with
+ * their exact geometry test.
+ */
+class Bvh {
+   public:
+    Bvh() = default;
+
+    /// Build over `boxes`; invalid boxes (min > max) are never reported.
+    explicit Bvh(const std::vector<Bounds>& boxes);
+
+    /// Number of indexed items.
+    size_t Size() const {
+        return m_ItemCount;
+    }
+
+    bool Empty() const {
+        return m_Nodes.empty();
+    }
+
+    /// Items whose box overlaps `box`.
+    std::vector<size_t> Overlapping(const Bounds& box) const;
+
+    /// Items whose box is within `radius` of point `p`.
+    std::vector<size_t> Near(const Vec3& p, double radius) const;
+
+    /// Items whose box the ray `origin + t * dir` (t in [0, maxT]) enters, as (item, t) sorted by t.
+    std::vector<std::pair<size_t, double>> Ray(const Vec3& origin, const Vec3& dir,
+                                               double maxT = std::numeric_limits<double>::infinity()) const;
+
+   private:
+    struct Node {
+        Bounds box;
+        uint32_t first = 0;  ///< Leaf: first slot in m_Items; inner: index of the right child
+        uint32_t count = 0;  ///< Leaf: item count; 0 for inner nodes (left child is this + 1)
+    };
+
+    uint32_t build(const std::vector<Vec3>& centers, uint32_t begin, uint32_t end);
+
+    std::vector<Node> m_Nodes;
+    std::vector<uint32_t> m_Items;
+    std::vector<Bounds> m_Boxes;
+    size_t m_ItemCount = 0;
+};
+
+}  // namespace ccad
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ccad {
+
+/** \name Execution budget
+ *
+ * One worker budget shared by everything that runs in parallel: OCCT's thread pool (booleans,
+ * meshing), the kernel's own data-parallel loops (selectors, STL export) and the schedulers of
+ * the applications (parts built in parallel). Parallel work only fans out while the budget has
+ * idle workers, so nested parallelism degrades to serial loops instead of multiplying threads.
+ *  \{ */
+
+/// Environment variable providing the default worker count.
+inline constexpr const char* kJobsEnvVar = "CCAD_JOBS";
+
+/// Current worker budget; defaults to $CCAD_JOBS, else the number of hardware threads.
+size_t WorkerCount();
+
+/// Set the worker budget (0 = default). Resizes the thread pools, so call it before starting work.
+void SetWorkerCount(size_t workers);
+
+/**
+ * @brief Marks the calling thread as one of the budget's busy workers.
+ *
+ * Schedulers wrap each job they run in a scope; kernel operations started from inside only go
+ * parallel with what is left of the budget.
+ */
+class WorkerScope {
+   public:
+    WorkerScope();
+    ~WorkerScope();
+
+    WorkerScope(const WorkerScope&) = delete;
+    WorkerScope& operator=(const WorkerScope&) = delete;
+
+   private:
+    bool m_Nested = false;  // the thread already was in a scope and is counted once
+};
+/** \} */
+
+}  // namespace ccad
@@ -0,0 +1,33 @@
+#pragma once
+#include <ccad/base/Math.hpp>
+#include <ccad/base/Shape.hpp>
+
+namespace ccad {
+
+/** \brief Volume, surface area and centroid of a shape. */
+struct MassProps {
+    double volume = 0.0;
+    double area = 0.0;
+    Vec3 centroid{0, 0, 0};  ///< Volume centroid; area centroid for shapes without volume
+};
+
+/** \brief Number of distinct sub-shapes per kind. */
+struct TopoCounts {
+    int solids = 0;
+    int shells = 0;
+    int faces = 0;
+    int edges = 0;
+    int vertices = 0;
+};
+
+/** \name Measurements
+ *
+ * Computed on first request and cached on the shape, so repeated queries are free.
+ *  \{ */
+MassProps MassProperties(const Shape& s);
+TopoCounts CountTopology(const Shape& s);
+/// Full topology and geometry check (BRepCheck_Analyzer).
+bool IsValidShape(const Shape& s);
+/** \} */
+
+}  // namespace ccad
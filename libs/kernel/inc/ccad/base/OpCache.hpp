@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ccad {
+
+/** \name Operation cache
+ *
+ * Primitives, booleans, transforms and features are memoised by a structural hash of their
+ * name, parameters and input shapes, so rerunning a script only recomputes the operations whose
+ * inputs changed. Hits and the time they saved are reported in KernelStats.
+ *  \{ */
+/// Drop all cached operation results.
+void ClearOpCache();
+/// Memory budget for cached results (default 256 MiB); 0 disables the cache.
+void SetOpCacheBudget(size_t bytes);
+/** \} */
+
+}  // namespace ccad
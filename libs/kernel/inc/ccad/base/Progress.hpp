@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace ccad {
+
+/**
+ * @brief Cooperative cancellation flag.
+ *
+ * Copies share the flag, so the requester keeps one copy and hands another to the thread doing
+ * the work (see OperationContext).
+ */
+class CancelToken {
+   public:
+    CancelToken() : m_Flag(std::make_shared<std::atomic<bool>>(false)) {
+    }
+
+    void Cancel() const {
+        m_Flag->store(true, std::memory_order_relaxed);
+    }
+
+    bool IsCancelled() const {
+        return m_Flag->load(std::memory_order_relaxed);
+    }
+
+   private:
+    std::shared_ptr<std::atomic<bool>> m_Flag;
+};
+
+/// Receives the progress of a long kernel operation (`stage` e.g. "Union", `fraction` in [0, 1]).
+/// May be called from OCCT worker threads.
+using ProgressSink = std::function<void(const char* stage, double fraction)>;
+
+/**
+ * @brief Cancellation token and progress sink for the kernel operations of the calling thread.
+ *
+ * Scoped and nestable. Booleans, fillets, chamfers, shelling, pipe shells and the mesher report
+ * progress to the sink and stop early once the token is cancelled; they then throw
+ * ccad::Exception with Status::CANCELLED. Without a context operations run as before.
+ *
+ * @code
+ * CancelToken token;
+ * OperationContext ctx(token, [](const char* stage, double f) { ... });
+ * auto s = ops::Union(a, b);  // another thread may call token.Cancel()
+ * @endcode
+ */
+class OperationContext {
+   public:
+    explicit OperationContext(CancelToken token, ProgressSink sink = {});
+    ~OperationContext();
+
+    OperationContext(const OperationContext&) = delete;
+    OperationContext& operator=(const OperationContext&) = delete;
+
+    const CancelToken& Token() const {
+        return m_Token;
+    }
+    const ProgressSink& Sink() const {
+        return m_Sink;
+    }
+
+    /// Innermost context of the calling thread, or nullptr.
+    static const OperationContext* Current();
+
+   private:
+    CancelToken m_Token;
+    ProgressSink m_Sink;
+    const OperationContext* m_Previous;
+};
+
+/// True if the calling thread's operation context has been cancelled.
+bool IsCancelled();
+
+/// Throw ccad::Exception(Status::CANCELLED) if the calling thread's context has been cancelled.
+void ThrowIfCancelled();
+
+}  // namespace ccad
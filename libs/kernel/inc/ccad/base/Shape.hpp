@@ -6,21 +6,20 @@
 
 namespace ccad {
 
-/** \brief Thin value handle to own a shape with nice pass/return semantics. */
+/**
+ * \brief Thin value handle to a shared, immutable shape.
+ *
+ * Copies share the implementation (reference counted, no allocation). Mutation goes through
+ * Detach(), which clones the implementation first if other handles still share it.
+ */
 class Shape {
    public:
     Shape() = default;
     explicit Shape(std::unique_ptr<IShape> p) : m_Ptr(std::move(p)) {
     }
 
-    // Deep-copy via Clone:
-    Shape(const Shape& rhs) : m_Ptr(rhs.m_Ptr ? rhs.m_Ptr->Clone() : nullptr) {
-    }
-    Shape& operator=(const Shape& rhs) {
-        if (this != &rhs) m_Ptr = rhs.m_Ptr ? rhs.m_Ptr->Clone() : nullptr;
-        return *this;
-    }
-
+    Shape(const Shape&) = default;
+    Shape& operator=(const Shape&) = default;
     Shape(Shape&&) noexcept = default;
     Shape& operator=(Shape&&) noexcept = default;
 
@@ -36,18 +35,30 @@ class Shape {
         return m_Ptr ? m_Ptr->BoundingBox() : Bounds{};
     }
 
-    IShape& Get() {
+    const IShape& Get() const {
         return *m_Ptr;
     }
-    const IShape& Get() const {
+
+    /// Mutable access for the rare in-place edit; clones first if the implementation is shared.
+    /// Not synchronized against other threads copying this same handle.
+    IShape& Detach() {
+        if (m_Ptr && m_Ptr.use_count() > 1) m_Ptr = m_Ptr->Clone();
         return *m_Ptr;
     }
 
+    /// True if both handles refer to the same implementation.
+    bool SharesWith(const Shape& other) const {
+        return m_Ptr == other.m_Ptr;
+    }
+
+    /// Return an owned copy of the implementation and leave this handle empty.
     std::unique_ptr<IShape> Release() {
-        return std::move(m_Ptr);
+        std::unique_ptr<IShape> out = m_Ptr ? m_Ptr->Clone() : nullptr;
+        m_Ptr.reset();
+        return out;
     }
 
    private:
-    std::unique_ptr<IShape> m_Ptr;
+    std::shared_ptr<IShape> m_Ptr;
 };
 }  // namespace ccad
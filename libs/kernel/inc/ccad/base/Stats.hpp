@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+namespace ccad {
+
+/**
+ * @brief Snapshot of kernel-wide counters.
+ *
+ * Counters accumulate over the whole session until ResetKernelStats() is called.
+ */
+struct KernelStats {
+    uint64_t meshCacheHits = 0;     ///< Triangulations served from the mesh cache
+    uint64_t meshCacheMisses = 0;   ///< Triangulations which had to run the mesher
+    uint64_t booleanFastPaths = 0;  ///< Booleans answered by the bounds prefilter without OCCT
+    uint64_t validityChecks = 0;    ///< Full BRepCheck_Analyzer runs (known-valid shapes skip them)
+    uint64_t opCacheHits = 0;       ///< Operations answered by the operation cache
+    uint64_t opCacheMisses = 0;     ///< Cacheable operations which had to be computed
+    double opCacheSavedMs = 0.0;    ///< Compute time the operation cache hits saved
+
+    friend std::ostream& operator<<(std::ostream& os, const KernelStats& s) {
+        os << "KernelStats(meshCache hits=" << s.meshCacheHits << ", misses=" << s.meshCacheMisses
+           << "; boolean fast paths=" << s.booleanFastPaths
+           << "; validity checks=" << s.validityChecks << "; op cache hits=" << s.opCacheHits
+           << ", misses=" << s.opCacheMisses << ", saved=" << s.opCacheSavedMs << "ms)";
+        return os;
+    }
+};
+
+/// \return Snapshot of the current kernel counters.
+KernelStats GetKernelStats();
+
+/// \return Operation cache counters of the calling thread only; the other fields stay zero.
+/// Lets one of several concurrent builds attribute cache activity to itself.
+KernelStats GetThreadKernelStats();
+
+/// \brief Reset all kernel counters (and the calling thread's operation cache counters) to zero.
+void ResetKernelStats();
+
+}  // namespace ccad
@@ -8,6 +8,7 @@ namespace ccad {
 enum class Status {
     SUCCESS = 0,
     ERROR_OCCT = 1,
+    CANCELLED = 2,  // aborted through a CancelToken
 
     ERROR_UNKNOWN = 0x7fffff01  // catch-all
 };
@@ -0,0 +1,23 @@
+#pragma once
+#include <ccad/base/Shape.hpp>
+#include <ccad/select/FaceSelector.hpp>
+
+namespace ccad {
+namespace feature {
+
+/**
+ * @brief Hollow a solid to a constant wall thickness, removing the given faces.
+ *
+ * Replaces the "outer minus shrunken inner" boolean pattern with a single offset operation.
+ * The walls grow inward; removed faces become the openings.
+ *
+ * @param s           Input solid
+ * @param openFaces   Faces to remove (from FaceSelector::collect()); may be empty for a closed cavity
+ * @param thicknessMm Wall thickness (> 0)
+ * @return Shape      Hollowed solid
+ * @throws Exception if the offset algorithm fails
+ */
+Shape Shell(const Shape& s, const select::FaceSet& openFaces, double thicknessMm);
+
+}  // namespace feature
+}  // namespace ccad
@@ -2,6 +2,8 @@
 
 #include <ccad/base/Math.hpp>
 #include <ccad/base/Shape.hpp>
+#include <memory>
+#include <string>
 
 namespace ccad {
 namespace geom {
@@ -10,20 +12,58 @@ namespace geom {
 class TriMesh {
    public:
     std::vector<Vec3> positions;
-    std::vector<Vec3> normals;
+    std::vector<Vec3> normals;  ///< Per vertex, evaluated on the B-rep surfaces (empty if not available)
     std::vector<unsigned> indices;
 
     friend std::ostream& operator<<(std::ostream& os, const TriMesh& mesh);
 };
 
-/** \brief Triangulation parameters */
+/**
+ * \brief Triangulation parameters
+ *
+ * With `relativeDeflection` > 0 the chordal deflection is derived per shape from its bounding-box
+ * diagonal and clamped to [minDeflection, maxDeflection]; otherwise `linearDeflection` is used as is.
+ */
 struct TriangulationParams {
-    double linearDeflection = 0.2;
+    double linearDeflection = 0.2;  ///< Absolute chordal deflection [mm]
     double angularDeflectionDeg = 20.0;
+    double relativeDeflection = 0.0;  ///< Fraction of the bbox diagonal, 0 = use linearDeflection
+    double minDeflection = 0.01;
+    double maxDeflection = 2.0;
+    bool curvatureAware = true;  ///< Also check the deflection inside faces, so curved faces refine locally
+    bool weld = false;           ///< Merge coincident vertices across faces unless their normals form a crease
+    double creaseAngleDeg = 30.0;
     bool parallel = true;
 };
 
+/** \brief Named tessellation presets (`--quality`). */
+enum class MeshQuality { Draft, Normal, Fine, Legacy };
+
+/// \return Parameters for the preset; `Legacy` is the former fixed 0.1 mm / 25° setting.
+TriangulationParams QualityPreset(MeshQuality q);
+
+/// Parse "draft", "normal", "fine" or "legacy"; \return false for unknown names.
+bool ParseMeshQuality(const std::string& name, MeshQuality& out);
+
+/// \return The absolute parameters used for `s`: the relative deflection resolved against its size.
+TriangulationParams ResolveParams(const Shape& s, const TriangulationParams& p);
+
+/**
+ * \brief Triangulate a shape.
+ *
+ * Results are cached per session by shape identity and deflection, so the viewer,
+ * the exporters and the batch tools mesh each distinct (shape, params) pair only once.
+ */
 TriMesh Triangulate(const Shape& s, const TriangulationParams& p = {});
 
+/// \brief Same as Triangulate(), but hands out the cached mesh without copying it.
+std::shared_ptr<const TriMesh> TriangulateShared(const Shape& s, const TriangulationParams& p = {});
+
+/// \brief Drop all cached triangulations.
+void ClearMeshCache();
+
+/// \brief Limit the memory held by cached triangulations (default 512 MiB).
+void SetMeshCacheBudget(size_t bytes);
+
 }  // namespace geom
 }  // namespace ccad
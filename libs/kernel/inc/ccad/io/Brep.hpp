@@ -0,0 +1,21 @@
+#pragma once
+
+#include <ccad/base/Shape.hpp>
+#include <optional>
+#include <string>
+
+namespace ccad {
+namespace io {
+
+/**
+ * \brief Write the exact B-rep of a shape in OCCT's binary BREP format.
+ *
+ * Lossless and much faster to read back than STEP, so it is used for on-disk result caches.
+ */
+bool SaveBREP(const Shape& shape, const std::string& path);
+
+/// Read a shape written by SaveBREP; \return nullopt if the file is missing or unreadable.
+std::optional<Shape> LoadBREP(const std::string& path);
+
+}  // namespace io
+}  // namespace ccad
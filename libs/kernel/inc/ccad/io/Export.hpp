@@ -4,11 +4,13 @@
 #include <string>
 
 #include "ccad/geom/Triangulation.hpp"
+#include "ccad/io/Stl.hpp"
 
 namespace ccad {
 namespace io {
 
-bool SaveSTL(const Shape& shape, const std::string& path, geom::TriangulationParams p);
+/// Triangulate (cached) and write the shape as STL; binary unless `opt` asks for ASCII.
+bool SaveSTL(const Shape& shape, const std::string& path, geom::TriangulationParams p, const StlOptions& opt = {});
 bool SaveSTEP(const Shape& shape, const std::string& path);
 
 }  // namespace io
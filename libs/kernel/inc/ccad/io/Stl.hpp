@@ -0,0 +1,30 @@
+#pragma once
+
+#include <ccad/geom/Triangulation.hpp>
+#include <cstddef>
+#include <string>
+
+namespace ccad {
+namespace io {
+
+/// STL encoding; binary is the default because it is several times smaller and faster to write and slice.
+enum class StlFormat { Binary, Ascii };
+
+/** \brief Options for the native STL writer. */
+struct StlOptions {
+    StlFormat format = StlFormat::Binary;
+    size_t chunkTriangles = 1 << 15;  ///< Triangles formatted per parallel task
+    size_t bufferBytes = 8 << 20;     ///< Size of the file stream buffer
+};
+
+/**
+ * \brief Serialize a triangle mesh as STL.
+ *
+ * Triangle records are formatted in parallel chunks and streamed to disk in order,
+ * so the output is byte-identical regardless of the number of threads.
+ * \return false if the file cannot be written or the mesh is malformed.
+ */
+bool WriteSTL(const geom::TriMesh& mesh, const std::string& path, const StlOptions& opt = {});
+
+}  // namespace io
+}  // namespace ccad
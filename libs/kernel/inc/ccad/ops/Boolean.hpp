@@ -4,10 +4,24 @@
 namespace ccad {
 namespace ops {
 
+/**
+ * \brief Bounds test run before a boolean to detect operands which cannot touch.
+ *
+ * Disjoint operands skip OCCT entirely: Union returns a compound, Difference the body unchanged
+ * and Intersection an empty compound. OBB is tighter for rotated parts but costs more to compute.
+ */
+enum class BooleanPrefilter { None, AABB, OBB };
+
+void SetBooleanPrefilter(BooleanPrefilter mode);
+BooleanPrefilter GetBooleanPrefilter();
+
 /** \name Boolean operations
  *  \{ */
+/// Fuse all shapes in one parallel General Fuse pass (falls back to a spatially ordered pairwise reduction).
 Shape Union(const std::vector<Shape>& shapes);
 Shape Difference(const Shape& a, const Shape& b);
+/// Subtract all tools from `a` in one parallel cut; tools which miss `a` are skipped.
+Shape Difference(const Shape& a, const std::vector<Shape>& tools);
 Shape Intersection(const Shape& a, const Shape& b);
 /** \} */
 
@@ -0,0 +1,35 @@
+#pragma once
+#include <ccad/base/Math.hpp>
+#include <ccad/base/Shape.hpp>
+
+namespace ccad {
+namespace ops {
+
+/** \name Patterns
+ *
+ * Patterns return a compound of located instances which all share the geometry of `s`,
+ * so memory does not grow with the instance count. With `fuse = true` the instances are
+ * additionally unioned into a single shape.
+ *  \{ */
+
+/// `count` instances, instance i translated by i * step.
+Shape LinearPattern(const Shape& s, int count, const Vec3& step, bool fuse = false);
+
+/// nx * ny instances on a grid in the XY plane with spacing dx, dy.
+Shape GridPattern(const Shape& s, int nx, double dx, int ny, double dy, bool fuse = false);
+
+/**
+ * \brief `count` instances evenly spaced on a circle of `radius` around the Z axis.
+ *
+ * Instance i sits at angle startDeg + i * 360 / count (0° = +X, CCW). With `orient` the
+ * instance is also rotated by that angle, otherwise it is only translated.
+ */
+Shape PolarPattern(const Shape& s, int count, double radius, double startDeg = 0.0, bool orient = true,
+                   bool fuse = false);
+
+/// Mirror `s` at the plane; mirroring flips orientation, so the result is an independent copy.
+Shape Mirror(const Shape& s, const Plane3& plane);
+/** \} */
+
+}  // namespace ops
+}  // namespace ccad
@@ -1,16 +1,29 @@
 #pragma once
+#include <ccad/base/Math.hpp>
 #include <ccad/base/Shape.hpp>
 
 namespace ccad {
 namespace ops {
 
+/** \brief Placement composed of uniform scale, Euler rotations (degrees) and translation. */
+struct Transform {
+    Vec3 translate{0, 0, 0};
+    Vec3 rotateDeg{0, 0, 0};
+    double scale = 1.0;
+};
+
 /** \name Transforms (returns new shapes)
+ *
+ * Translations and rotations only relocate the shape and share its geometry with the input;
+ * scaling (or `copy = true`) creates an independent copy.
  *  \{ */
 Shape Translate(const Shape& s, double dx, double dy, double dz);
 Shape RotateX(const Shape& s, double deg);
 Shape RotateY(const Shape& s, double deg);
 Shape RotateZ(const Shape& s, double deg);
 Shape ScaleUniform(const Shape& s, double factor);
+/// Apply scale, then rotate about X, Y, Z, then translate, as one transformation.
+Shape Apply(const Shape& s, const Transform& t, bool copy = false);
 /** \} */
 
 }  // namespace ops
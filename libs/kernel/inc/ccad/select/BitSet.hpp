@@ -0,0 +1,147 @@
+#pragma once
+/**
+ * @file BitSet.hpp
+ * @brief Dynamic bitset over a selector's element indices.
+ *
+ * Selections (edges, faces) are dense index ranges, so set algebra is done word-wise
+ * on 64-bit blocks instead of through hash sets.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ccad::select {
+
+class BitSet {
+   public:
+    BitSet() = default;
+
+    /// Create a set of `n` bits, all cleared (or all set).
+    explicit BitSet(size_t n, bool value = false) : m_size(n), m_words((n + 63) / 64, value ? ~uint64_t(0) : 0) {
+        trim();
+    }
+
+    /// Number of addressable bits.
+    size_t size() const {
+        return m_size;
+    }
+
+    /// Number of set bits.
+    size_t count() const {
+        size_t c = 0;
+        for (uint64_t w : m_words) c += Popcount(w);
+        return c;
+    }
+
+    bool none() const {
+        for (uint64_t w : m_words)
+            if (w) return false;
+        return true;
+    }
+
+    bool test(size_t i) const {
+        return i < m_size && (m_words[i >> 6] >> (i & 63)) & 1u;
+    }
+
+    void set(size_t i) {
+        m_words[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+
+    void reset(size_t i) {
+        m_words[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    }
+
+    /// Union (sizes must match).
+    BitSet& operator|=(const BitSet& b) {
+        for (size_t w = 0; w < m_words.size(); ++w) m_words[w] |= b.m_words[w];
+        return *this;
+    }
+
+    /// Intersection (sizes must match).
+    BitSet& operator&=(const BitSet& b) {
+        for (size_t w = 0; w < m_words.size(); ++w) m_words[w] &= b.m_words[w];
+        return *this;
+    }
+
+    /// Difference: clear every bit set in `b` (sizes must match).
+    BitSet& andNot(const BitSet& b) {
+        for (size_t w = 0; w < m_words.size(); ++w) m_words[w] &= ~b.m_words[w];
+        return *this;
+    }
+
+    /// Pack a byte mask (non-zero = set) of `size()` entries into the set.
+    void assignMask(const uint8_t* mask) {
+        for (size_t w = 0; w < m_words.size(); ++w) {
+            const size_t base = w * 64;
+            const size_t n = (m_size - base) < 64 ? (m_size - base) : 64;
+            uint64_t bits = 0;
+            for (size_t b = 0; b < n; ++b) bits |= uint64_t(mask[base + b] != 0) << b;
+            m_words[w] = bits;
+        }
+    }
+
+    /// Call `f(index)` for every set bit in ascending order.
+    template <typename F>
+    void forEach(F&& f) const {
+        for (size_t w = 0; w < m_words.size(); ++w) {
+            uint64_t bits = m_words[w];
+            while (bits) {
+                f(w * 64 + CountTrailingZeros(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    /// Set indices in ascending order.
+    std::vector<size_t> indices() const {
+        std::vector<size_t> out;
+        out.reserve(count());
+        forEach([&](size_t i) { out.push_back(i); });
+        return out;
+    }
+
+   private:
+    size_t m_size = 0;
+    std::vector<uint64_t> m_words;
+
+    /// Keep unused bits of the last word cleared so count()/none() stay exact.
+    void trim() {
+        if (m_size & 63) m_words.back() &= (uint64_t(1) << (m_size & 63)) - 1;
+    }
+
+    static unsigned Popcount(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcountll(w));
+#elif defined(_MSC_VER)
+        return static_cast<unsigned>(__popcnt64(w));
+#else
+        unsigned c = 0;
+        for (; w; w &= w - 1) ++c;
+        return c;
+#endif
+    }
+
+    static unsigned CountTrailingZeros(uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(w));
+#elif defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanForward64(&idx, w);
+        return static_cast<unsigned>(idx);
+#else
+        unsigned c = 0;
+        while (!(w & 1)) {
+            w >>= 1;
+            ++c;
+        }
+        return c;
+#endif
+    }
+};
+
+}  // namespace ccad::select
@@ -3,17 +3,22 @@
  * @file EdgeSelector.hpp
  * @brief Query-style edge selection for fillet/chamfer and analysis.
  *
- * Public API is OCCT-free. Internally, the implementation builds a fast
- * per-edge cache (type, length, radius, an approximate direction, a sample point,
- * dihedral angle if planar faces are adjacent, etc.) and then applies chainable
- * filters. This keeps interactive use fast and code maintainable.
+ * Public API is OCCT-free. Internally, the implementation keeps a per-edge
+ * attribute table (type, length, radius, an approximate direction, a sample point,
+ * dihedral angle if planar faces are adjacent, etc.) and applies chainable filters.
+ * Attributes are computed lazily, in parallel, the first time a filter needs them, and
+ * kept as structure-of-arrays columns so each filter is a tight loop over one column.
+ * Region queries (inside a box, near a point) go through a BVH over the edge boxes.
  */
 
 #include <ccad/base/Math.hpp>
 #include <ccad/base/Shape.hpp>
+#include <ccad/select/BitSet.hpp>
 #include <glm/vec3.hpp>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 namespace ccad::select {
@@ -39,7 +44,8 @@ struct RadiusRange {
  * @brief Lightweight, stable description of an edge for downstream use.
  *
  * This is safe to pass around in the kernel and UI; it contains no OCCT types.
- * Use `index` as a stable identifier within the originating EdgeSelector.
+ * Use `index` as a stable identifier within the originating EdgeSelector. All attributes
+ * are filled; groups no filter needed are computed when the refs are materialized.
  */
 struct EdgeRef {
     size_t index = 0;            ///< Stable index within the selector’s internal table
@@ -51,19 +57,34 @@ struct EdgeRef {
     double dihedralDeg = 180.0;  ///< Angle between adjacent planar faces; 180≈smooth, small≈sharp
 };
 
+class EdgeTable;  // per-shape attribute columns, defined in the implementation
+
 /**
- * @brief A small container for selected edges with set-algebra convenience.
+ * @brief A selection of edges stored as a bitset over the selector's edge indices.
+ *
+ * Set algebra is word-wise (OR / AND / AND-NOT). Sets from selectors of the same shape can be
+ * combined; combining sets of different shapes throws.
  */
 class EdgeSet {
    public:
-    const std::vector<EdgeRef>& items() const {
-        return m_items;
+    /// Materialize the selected edges in index order, computing any attribute group still missing.
+    std::vector<EdgeRef> items() const;
+    /// Selected edge indices in ascending order.
+    std::vector<size_t> indices() const {
+        return m_bits.indices();
+    }
+    const BitSet& bits() const {
+        return m_bits;
+    }
+    /// Edge table the indices refer to (opaque outside the kernel).
+    const std::shared_ptr<EdgeTable>& table() const {
+        return m_table;
     }
     bool empty() const {
-        return m_items.empty();
+        return m_bits.none();
     }
     size_t size() const {
-        return m_items.size();
+        return m_bits.count();
     }
 
     /// Union with another set (in-place). Index is the identity.
@@ -74,8 +95,9 @@ class EdgeSet {
     EdgeSet& subtract(const EdgeSet& b);
 
    private:
-    std::vector<EdgeRef> m_items;
-    friend class EdgeSelector;  // so selector can fill items efficiently
+    std::shared_ptr<EdgeTable> m_table;
+    BitSet m_bits;
+    friend class EdgeSelector;  // so selector can fill the bits efficiently
 };
 
 /**
@@ -94,7 +116,7 @@ class EdgeSet {
  */
 class EdgeSelector {
    public:
-    /// Build a selector from a Shape. A cache of edge attributes is computed once.
+    /// Build a selector from a Shape. Only enumerates the edges; attributes are computed on demand.
     static EdgeSelector FromShape(const ccad::Shape& shape, double tolerance = 1e-6);
 
     // -------- chainable filters (each returns *this) --------
@@ -120,19 +142,22 @@ class EdgeSelector {
     /// Keep edges located on a specific AABB side of the *shape’s* bounding box (with tolerance).
     EdgeSelector& onBoxSide(BoxSide side, double tol = 1e-6);
 
-    /// Keep edges whose sample point lies inside the given axis-aligned box.
+    /// Keep edges whose sample point lies inside the given axis-aligned box (BVH-accelerated).
     EdgeSelector& insideAABB(const glm::vec3& minP, const glm::vec3& maxP);
 
+    /// Keep edges within `radius` of point `p` (BVH candidates, exact distance).
+    EdgeSelector& nearPoint(const glm::vec3& p, double radius);
+
     // -------- execute --------
 
     /// Evaluate the filters and return the resulting set.
     EdgeSet collect() const;
 
    private:
-    struct Impl;                   // PIMPL to hide OCCT
-    std::shared_ptr<Impl> m_impl;  // shared so copies are cheap
-    explicit EdgeSelector(std::shared_ptr<Impl> impl) : m_impl(std::move(impl)) {
+    std::shared_ptr<EdgeTable> m_table;  // hides OCCT; shared so copies are cheap
+    explicit EdgeSelector(std::shared_ptr<EdgeTable> table) : m_table(std::move(table)) {
     }
+    friend class EdgeSelectorCache;
 
     // filter state
     struct Filters {
@@ -144,8 +169,36 @@ class EdgeSelector {
         std::optional<std::tuple<Axis, double, double>> planeAxisValTol;
         std::optional<std::pair<BoxSide, double>> boxSideTol;
         std::optional<std::pair<glm::vec3, glm::vec3>> aabb;
+        std::optional<std::pair<glm::vec3, double>> nearPoint;
     };
     Filters m_filters{};
 };
 
+/**
+ * @brief Weak cache of edge tables keyed by shape identity.
+ *
+ * Selectors created through the cache for the same shape (and tolerance) share one edge table,
+ * so attributes computed for one query are reused by the next. Entries are held weakly: a
+ * table lives only as long as some selector or EdgeSet refers to it. Thread-safe.
+ */
+class EdgeSelectorCache {
+   public:
+    /// Like EdgeSelector::FromShape, but reuses a live table for the same shape.
+    EdgeSelector FromShape(const ccad::Shape& shape, double tolerance = 1e-6);
+
+    /// Forget all entries (e.g. at the start of a script run).
+    void Clear();
+
+    /// Number of entries whose table is still alive.
+    size_t Size() const;
+
+   private:
+    struct Entry {
+        std::weak_ptr<EdgeTable> table;
+        double tolerance = 0.0;
+    };
+    mutable std::mutex m_Mutex;
+    std::unordered_multimap<const void*, Entry> m_Entries;  // keyed by the shape's TShape
+};
+
 }  // namespace ccad::select
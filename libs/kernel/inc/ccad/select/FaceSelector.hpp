@@ -0,0 +1,147 @@
+#pragma once
+/**
+ * @file FaceSelector.hpp
+ * @brief Query-style face selection for shelling, face-targeted features and analysis.
+ *
+ * Same model as EdgeSelector: an OCCT-free API over a per-shape face table whose attributes
+ * (surface type, normal, area, centroid, adjacency) are computed lazily and in parallel, and
+ * selections stored as bitsets over the face indices. Proximity and ray queries go through a
+ * BVH over the face boxes, built once per table.
+ */
+
+#include <ccad/base/Math.hpp>
+#include <ccad/base/Shape.hpp>
+#include <ccad/select/BitSet.hpp>
+#include <ccad/select/EdgeSelector.hpp>
+#include <glm/vec3.hpp>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace ccad::select {
+
+/// Surface kind of a face.
+enum class FaceGeom { Any, Plane, Cylinder, Cone, Sphere, Torus, Other };
+
+struct AreaRange {
+    double min = 0.0, max = 1e100;
+};
+
+/**
+ * @brief Lightweight description of a face for downstream use.
+ *
+ * All attributes are filled; groups no filter needed are computed when the refs are materialized.
+ */
+struct FaceRef {
+    size_t index = 0;               ///< Stable index within the selector’s internal table
+    FaceGeom geom = FaceGeom::Any;  ///< Surface type
+    glm::vec3 normal{};             ///< Outward normal at the middle of the UV range
+    glm::vec3 centroid{};           ///< Area centroid (world coordinates)
+    double area = 0.0;              ///< Face area
+    std::vector<size_t> neighbors;  ///< Faces sharing an edge
+};
+
+class FaceTable;  // per-shape attribute columns, defined in the implementation
+
+/**
+ * @brief A selection of faces stored as a bitset over the selector's face indices.
+ */
+class FaceSet {
+   public:
+    /// Materialize the selected faces in index order, computing any attribute group still missing.
+    std::vector<FaceRef> items() const;
+    /// Selected face indices in ascending order.
+    std::vector<size_t> indices() const {
+        return m_bits.indices();
+    }
+    const BitSet& bits() const {
+        return m_bits;
+    }
+    /// Face table the indices refer to (opaque outside the kernel).
+    const std::shared_ptr<FaceTable>& table() const {
+        return m_table;
+    }
+    bool empty() const {
+        return m_bits.none();
+    }
+    size_t size() const {
+        return m_bits.count();
+    }
+
+    /// Union with another set (in-place).
+    FaceSet& unite(const FaceSet& b);
+    /// Intersection with another set (in-place).
+    FaceSet& intersect(const FaceSet& b);
+    /// Subtract another set (in-place).
+    FaceSet& subtract(const FaceSet& b);
+
+   private:
+    std::shared_ptr<FaceTable> m_table;
+    BitSet m_bits;
+    friend class FaceSelector;
+};
+
+/**
+ * @brief Chainable query builder over the faces of a Shape.
+ *
+ * @code
+ * auto top = FaceSelector::FromShape(box).geom(FaceGeom::Plane).onBoxSide(BoxSide::ZMax).collect();
+ * auto cup = feature::Shell(box, top, 2.0);
+ * @endcode
+ */
+class FaceSelector {
+   public:
+    /// Build a selector from a Shape. Only enumerates the faces; attributes are computed on demand.
+    static FaceSelector FromShape(const ccad::Shape& shape, double tolerance = 1e-6);
+
+    // -------- chainable filters (each returns *this) --------
+
+    /// Keep faces of a given surface type.
+    FaceSelector& geom(FaceGeom g);
+
+    /// Keep faces whose normal is parallel (either direction) to an axis within tolDeg.
+    FaceSelector& normalParallelTo(Axis axis, double tolDeg = 5.0);
+
+    /// Keep faces whose centroid lies on a side of the *shape’s* bounding box.
+    FaceSelector& onBoxSide(BoxSide side, double tol = 1e-6);
+
+    /// Keep faces with area within [min, max].
+    FaceSelector& areaBetween(const AreaRange& r);
+
+    /// Keep faces sharing an edge with any face of `seeds` (seeds themselves excluded).
+    FaceSelector& adjacentTo(const FaceSet& seeds);
+
+    /// Keep faces within `radius` of point `p` (BVH candidates, exact distance).
+    FaceSelector& nearPoint(const glm::vec3& p, double radius);
+
+    /// Keep faces hit by the ray `origin + t * dir` (t >= 0); with `firstOnly` only the nearest hit.
+    FaceSelector& hitByRay(const glm::vec3& origin, const glm::vec3& dir, bool firstOnly = false);
+
+    /// After all other filters, keep only the `n` largest faces by area.
+    FaceSelector& largest(size_t n = 1);
+
+    // -------- execute --------
+
+    /// Evaluate the filters and return the resulting set.
+    FaceSet collect() const;
+
+   private:
+    std::shared_ptr<FaceTable> m_table;  // hides OCCT; shared so copies are cheap
+    explicit FaceSelector(std::shared_ptr<FaceTable> table) : m_table(std::move(table)) {
+    }
+
+    struct Filters {
+        std::optional<FaceGeom> geom;
+        std::optional<std::pair<Axis, double>> normalAxisTolDeg;
+        std::optional<std::pair<BoxSide, double>> boxSideTol;
+        std::optional<AreaRange> area;
+        std::optional<BitSet> adjacentTo;
+        std::optional<size_t> largest;
+        std::optional<std::pair<glm::vec3, double>> nearPoint;
+        std::optional<std::tuple<glm::vec3, glm::vec3, bool>> ray;
+    };
+    Filters m_filters{};
+};
+
+}  // namespace ccad::select
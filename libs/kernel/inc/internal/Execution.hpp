@@ -0,0 +1,47 @@
+#pragma once
+/**
+ * @file Execution.hpp
+ * @brief Claiming idle workers of the execution budget for one parallel section.
+ */
+
+#include <cstddef>
+
+#include "ccad/base/Execution.hpp"
+
+namespace ccad {
+
+/// How a WorkerLease treats a budget with fewer idle workers than wanted.
+enum class LeaseMode {
+    Partial,       ///< take what is idle; the caller sizes its fan-out to Count()
+    AllOrNothing,  ///< take all `wanted` workers or none
+};
+
+/**
+ * Reserves up to `wanted` idle workers of the budget for its lifetime, in addition to the
+ * calling thread. Count() is 0 when the budget is used up, and the caller then runs serially.
+ * OCCT algorithms cannot be sized per call, they fan out over OCCT's whole pool, so they only
+ * go parallel while every other worker is idle:
+ *
+ * @code
+ * WorkerLease lease(WorkerCount() - 1, LeaseMode::AllOrNothing);
+ * algo.SetRunParallel(lease.Count() > 0);
+ * @endcode
+ */
+class WorkerLease {
+   public:
+    explicit WorkerLease(size_t wanted, LeaseMode mode = LeaseMode::Partial);
+    ~WorkerLease();
+
+    WorkerLease(const WorkerLease&) = delete;
+    WorkerLease& operator=(const WorkerLease&) = delete;
+
+    /// Extra workers granted.
+    size_t Count() const {
+        return m_Count;
+    }
+
+   private:
+    size_t m_Count = 0;
+};
+
+}  // namespace ccad
@@ -0,0 +1,69 @@
+#pragma once
+/**
+ * @file Hash.hpp
+ * @brief Stable 64-bit hashing of operation names and parameters.
+ *
+ * Values depend only on the bytes fed in (never on addresses), so keys built from them are
+ * reproducible across runs and processes.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "ccad/base/Math.hpp"
+
+namespace ccad {
+
+class Hasher {
+   public:
+    /// Integers, bools and enums hash by value.
+    template <typename T, typename = std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value>>
+    Hasher& Add(T v) {
+        return AddBits(static_cast<uint64_t>(static_cast<int64_t>(v)));
+    }
+
+    /// Bit pattern of the value; -0.0 hashes like 0.0.
+    Hasher& Add(double v) {
+        if (v == 0.0) v = 0.0;
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return AddBits(bits);
+    }
+
+    Hasher& Add(const char* s) {
+        return Add(std::string(s));
+    }
+
+    Hasher& Add(const std::string& s) {
+        uint64_t h = 0xcbf29ce484222325ull;  // FNV-1a over the bytes, then mixed in
+        for (unsigned char c : s) h = (h ^ c) * 0x100000001b3ull;
+        return AddBits(h ^ s.size());
+    }
+
+    Hasher& Add(const Vec3& v) {
+        return Add(v.x).Add(v.y).Add(v.z);
+    }
+
+    uint64_t Value() const {
+        return m_State;
+    }
+
+   private:
+    Hasher& AddBits(uint64_t v) {
+        m_State = Mix(m_State ^ (v + 0x9e3779b97f4a7c15ull + (m_State << 6) + (m_State >> 2)));
+        return *this;
+    }
+
+    /// splitmix64 finalizer
+    static uint64_t Mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t m_State = 0x6a09e667f3bcc909ull;
+};
+
+}  // namespace ccad
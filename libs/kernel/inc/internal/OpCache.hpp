@@ -0,0 +1,139 @@
+#pragma once
+#include <gp_Trsf.hxx>
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ccad/base/Shape.hpp"
+#include "ccad/select/BitSet.hpp"
+#include "internal/Hash.hpp"
+#include "internal/geom/ShapeHelper.hpp"
+
+namespace ccad {
+
+/**
+ * @brief Structural key of a kernel operation.
+ *
+ * Hashes the operation name, its parameters and the keys of its input shapes. An input without
+ * a key (imported or edited shape) makes the whole operation uncacheable.
+ */
+class OpKey {
+   public:
+    explicit OpKey(const char* op) {
+        m_Hash.Add(op);
+    }
+
+    OpKey& Input(const Shape& s) {
+        auto os = ShapeAsOcct(s);
+        const uint64_t k = os ? os->Key() : 0;
+        if (k == 0) m_Cacheable = false;
+        m_Hash.Add(k);
+        return *this;
+    }
+
+    OpKey& Inputs(const std::vector<Shape>& shapes) {
+        m_Hash.Add(shapes.size());
+        for (const auto& s : shapes) Input(s);
+        return *this;
+    }
+
+    template <typename T>
+    OpKey& Param(const T& v) {
+        m_Hash.Add(v);
+        return *this;
+    }
+
+    /// Selected element indices (edges, faces) of the input shape.
+    OpKey& Param(const select::BitSet& bits) {
+        m_Hash.Add(bits.size());
+        bits.forEach([this](size_t i) { m_Hash.Add(i); });
+        return *this;
+    }
+
+    OpKey& Param(const gp_Trsf& tr) {
+        for (int r = 1; r <= 3; ++r)
+            for (int c = 1; c <= 4; ++c) m_Hash.Add(tr.Value(r, c));
+        return *this;
+    }
+
+    /// Non-zero key, or 0 if the operation cannot be cached.
+    uint64_t Value() const {
+        return m_Cacheable ? (m_Hash.Value() | 1) : 0;
+    }
+
+   private:
+    Hasher m_Hash;
+    bool m_Cacheable = true;
+};
+
+/**
+ * @brief Session-wide LRU cache of operation results keyed by OpKey.
+ *
+ * Results are immutable shapes, so a hit hands out the cached handle itself. Entries are evicted
+ * least-recently-used once their estimated size exceeds the byte budget; a budget of 0 disables
+ * the cache.
+ */
+class OpCache {
+   public:
+    static OpCache& Instance();
+
+    /// Cached result for `key`, or run `build`, tag its result with `key` and store it.
+    template <typename Build>
+    Shape GetOrCreate(uint64_t key, Build&& build) {
+        if (key == 0 || !Enabled()) return build();
+
+        Shape hit;
+        if (Lookup(key, hit)) return hit;
+
+        const auto start = std::chrono::steady_clock::now();
+        Shape out = build();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        Store(key, out, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        return out;
+    }
+
+    void Clear();
+    void SetBudget(size_t bytes);
+    size_t Size() const;
+
+   private:
+    struct Entry {
+        uint64_t key = 0;
+        Shape shape;
+        size_t bytes = 0;
+        uint64_t buildNs = 0;  // time the result took to compute, credited on every hit
+    };
+
+    OpCache() = default;
+
+    bool Enabled() const;
+    bool Lookup(uint64_t key, Shape& out);
+    void Store(uint64_t key, const Shape& s, uint64_t buildNs);
+    void EvictLocked();
+
+    mutable std::mutex m_Mutex;
+    std::list<Entry> m_Lru;  // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> m_Index;
+    size_t m_Bytes = 0;
+    size_t m_Budget = size_t(256) << 20;  // 256 MiB
+};
+
+/// Tag a cheaply computed result with its key without caching it, so operations on it stay cacheable.
+inline Shape Keyed(const OpKey& key, Shape s) {
+    auto os = ShapeAsOcct(s);
+    if (os && key.Value() != 0) os->SetKey(key.Value());
+    return s;
+}
+
+/// Run `build` through the operation cache under `key` (see OpKey).
+template <typename Build>
+Shape Memoize(const OpKey& key, Build&& build) {
+    return OpCache::Instance().GetOrCreate(key.Value(), std::forward<Build>(build));
+}
+
+}  // namespace ccad
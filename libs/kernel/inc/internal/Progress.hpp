@@ -0,0 +1,67 @@
+#pragma once
+/**
+ * @file Progress.hpp
+ * @brief Bridge from the thread's OperationContext to OCCT's progress indicators.
+ */
+
+#include <Message_ProgressIndicator.hxx>
+#include <Message_ProgressRange.hxx>
+
+#include "ccad/base/Progress.hpp"
+
+namespace ccad {
+
+/// Progress indicator forwarding to a context's sink; OCCT algorithms stop once UserBreak() is true.
+class OcctProgressIndicator : public Message_ProgressIndicator {
+   public:
+    OcctProgressIndicator(const char* stage, CancelToken token, ProgressSink sink)
+        : m_Stage(stage), m_Token(std::move(token)), m_Sink(std::move(sink)) {
+    }
+
+    Standard_Boolean UserBreak() override {
+        return m_Token.IsCancelled();
+    }
+
+   protected:
+    void Show(const Message_ProgressScope& /*scope*/, const Standard_Boolean /*isForce*/) override {
+        if (m_Sink) m_Sink(m_Stage, GetPosition());
+    }
+
+   private:
+    const char* m_Stage;
+    CancelToken m_Token;
+    ProgressSink m_Sink;
+};
+
+/**
+ * Progress of one OCCT call. Hands out a range bound to the current OperationContext (a null
+ * range without one) and turns a user break into a CANCELLED exception:
+ *
+ * @code
+ * OperationProgress progress("Union");
+ * algo.Build(progress.Range());
+ * progress.ThrowIfCancelled();
+ * @endcode
+ */
+class OperationProgress {
+   public:
+    explicit OperationProgress(const char* stage) {
+        if (const auto* ctx = OperationContext::Current()) {
+            ccad::ThrowIfCancelled();
+            m_Indicator = new OcctProgressIndicator(stage, ctx->Token(), ctx->Sink());
+        }
+    }
+
+    Message_ProgressRange Range() {
+        return m_Indicator.IsNull() ? Message_ProgressRange() : m_Indicator->Start();
+    }
+
+    void ThrowIfCancelled() const {
+        if (!m_Indicator.IsNull()) ccad::ThrowIfCancelled();
+    }
+
+   private:
+    Handle(OcctProgressIndicator) m_Indicator;
+};
+
+}  // namespace ccad
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ccad {
+
+/** \brief Live counters behind ccad::KernelStats (kernel-internal, thread-safe). */
+struct KernelCounters {
+    std::atomic<uint64_t> meshCacheHits{0};
+    std::atomic<uint64_t> meshCacheMisses{0};
+    std::atomic<uint64_t> booleanFastPaths{0};
+    std::atomic<uint64_t> validityChecks{0};
+    std::atomic<uint64_t> opCacheHits{0};
+    std::atomic<uint64_t> opCacheMisses{0};
+    std::atomic<uint64_t> opCacheSavedNs{0};
+};
+
+/** \brief Operation cache counters of one thread, next to the process-wide ones. */
+struct ThreadOpCacheCounters {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t savedNs = 0;
+};
+
+/// \return The process-wide counter instance.
+KernelCounters& Counters();
+
+/// \return The calling thread's operation cache counters.
+ThreadOpCacheCounters& ThreadCounters();
+
+}  // namespace ccad
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ccad {
+
+/**
+ * @brief Small fixed-size worker pool used by the kernel's data-parallel loops.
+ *
+ * Tasks submitted from inside a worker are not special-cased here; callers which
+ * may run nested (see ParallelFor) check InWorker() and run inline instead. Callers also claim
+ * a WorkerLease from the execution budget and keep at most that many tasks running.
+ */
+class ThreadPool {
+   public:
+    explicit ThreadPool(size_t workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Number of worker threads.
+    size_t Size() const {
+        return m_Workers.size();
+    }
+
+    /// Queue a task and return a future for its result.
+    template <typename F>
+    auto Submit(F&& fn) -> std::future<std::invoke_result_t<F>> {
+        using R = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(fn));
+        auto future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Queue.emplace_back([task]() { (*task)(); });
+        }
+        m_Cv.notify_one();
+        return future;
+    }
+
+    /// True if the calling thread is a worker of any ThreadPool.
+    static bool InWorker();
+
+    /// Kernel-wide pool, one worker less than the budget (the caller is the last one).
+    static std::shared_ptr<ThreadPool> Shared();
+
+    /// Replace the shared pool for a new budget; holders of the old pool finish on it.
+    static void Resize(size_t budget);
+
+   private:
+    void WorkerLoop();
+
+   private:
+    std::vector<std::thread> m_Workers;
+    std::deque<std::function<void()>> m_Queue;
+    std::mutex m_Mutex;
+    std::condition_variable m_Cv;
+    bool m_Stop = false;
+};
+
+/**
+ * @brief Split [begin, end) into chunks of at least `grain` items and run `fn(chunkBegin, chunkEnd)`
+ * on the shared pool. The calling thread works on the first chunk itself.
+ *
+ * Runs inline when the range is small, the execution budget has no idle worker, or the caller
+ * already is a pool worker (nested parallelism degrades to a serial loop instead of deadlocking
+ * or oversubscribing).
+ * The first exception thrown by any chunk is rethrown after all chunks finished.
+ */
+void ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+}  // namespace ccad
@@ -0,0 +1,71 @@
+#pragma once
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_TShape.hxx>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "ccad/geom/Triangulation.hpp"
+
+namespace ccad::geom {
+
+/**
+ * @brief Session-wide cache of triangulated shapes.
+ *
+ * Entries are keyed by shape identity (TShape, location and orientation) plus the
+ * resolved (absolute) tessellation parameters. Each distinct key is meshed exactly once: concurrent
+ * requests for the same key wait for the first one instead of meshing again.
+ * Ready entries are evicted least-recently-used once the byte budget is exceeded.
+ */
+class MeshCache {
+   public:
+    using MeshPtr = std::shared_ptr<const TriMesh>;
+    using Builder = std::function<TriMesh()>;
+
+    static MeshCache& Instance();
+
+    /// Return the cached mesh for (shape, params) or run `build` once and store its result.
+    MeshPtr GetOrCreate(const TopoDS_Shape& shape, const TriangulationParams& p, const Builder& build);
+
+    void Clear();
+    void SetBudget(size_t bytes);
+
+   private:
+    struct Entry {
+        TopoDS_Shape shape;  // keeps the TShape alive, so the bucket key cannot be reused
+        double linearDeflection = 0.0;
+        double angularDeflectionDeg = 0.0;
+        bool curvatureAware = false;
+        bool weld = false;
+        double creaseAngleDeg = 0.0;
+        std::shared_future<MeshPtr> mesh;
+        size_t bytes = 0;  // 0 while the mesh is still being built
+        uint64_t lastUse = 0;
+
+        bool Matches(const TopoDS_Shape& s, const TriangulationParams& p) const {
+            return linearDeflection == p.linearDeflection && angularDeflectionDeg == p.angularDeflectionDeg &&
+                   curvatureAware == p.curvatureAware && weld == p.weld &&
+                   (!weld || creaseAngleDeg == p.creaseAngleDeg) && shape.IsEqual(s);
+        }
+    };
+    using EntryPtr = std::shared_ptr<Entry>;
+    using Key = const TopoDS_TShape*;
+
+    MeshCache() = default;
+
+    void Remove(Key key, const EntryPtr& e);
+    void EvictLocked(const EntryPtr& keep);
+
+   private:
+    std::mutex m_Mutex;
+    std::unordered_map<Key, std::vector<EntryPtr>> m_Entries;
+    size_t m_Bytes = 0;
+    size_t m_Budget = size_t(512) << 20;  // 512 MiB
+    uint64_t m_Tick = 0;
+};
+
+}  // namespace ccad::geom
@@ -1,18 +1,29 @@
 #pragma once
+#include <Bnd_Box.hxx>
+#include <Bnd_OBB.hxx>
 #include <TopoDS_Shape.hxx>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 
 #include "ccad/base/IShape.hpp"
+#include "ccad/base/Measure.hpp"
 #include "ccad/base/Math.hpp"
 
 namespace ccad {
 
-/** \brief Concrete IShape implementation that owns an OCCT TopoDS_Shape. */
+/**
+ * \brief Concrete IShape implementation that owns an OCCT TopoDS_Shape.
+ *
+ * Derived properties (boxes, validity, mass properties, topology counts) are computed on first
+ * request and cached. Clones share the cache; mutable access through Occt() drops it.
+ */
 class OcctShape final : public IShape {
    public:
-    explicit OcctShape(const TopoDS_Shape& s) : m_Shape(s) {
+    explicit OcctShape(const TopoDS_Shape& s) : m_Shape(s), m_Cache(std::make_shared<Cache>()) {
     }
-    explicit OcctShape(TopoDS_Shape&& s) : m_Shape(std::move(s)) {
+    explicit OcctShape(TopoDS_Shape&& s) : m_Shape(std::move(s)), m_Cache(std::make_shared<Cache>()) {
     }
 
     std::string TypeName() const override {
@@ -22,18 +33,60 @@ class OcctShape final : public IShape {
     Bounds BoundingBox() const override;
 
     std::unique_ptr<IShape> Clone() const override {
-        return std::make_unique<OcctShape>(m_Shape);  // TopoDS_Shape is a handle (shared) – OK for clone semantics
+        return std::unique_ptr<IShape>(new OcctShape(m_Shape, m_Cache));  // TopoDS_Shape is a handle (shared)
     }
 
     const TopoDS_Shape& Occt() const {
         return m_Shape;
     }
+    /// Mutable access; the cached properties no longer apply and are dropped.
     TopoDS_Shape& Occt() {
+        m_Cache = std::make_shared<Cache>();
         return m_Shape;
     }
 
+    /** \name Cached properties (computed once, thread-safe)
+     *  \{ */
+    const Bnd_Box& AxisBox() const;
+    /// Optimal oriented box; void for empty shapes.
+    const Bnd_OBB& OrientedBox() const;
+    /// Validity of the shape; runs BRepCheck_Analyzer at most once, and not at all if it was marked valid.
+    bool IsValid() const;
+    /// Record that the producer guarantees validity (primitives, successful booleans).
+    void MarkValid() const;
+    /// True if validity is already known, i.e. IsValid() is free.
+    bool ValidityKnown() const;
+    const MassProps& Mass() const;
+    const TopoCounts& Counts() const;
+    /** \} */
+
+    /// Structural key of the operation which produced this shape; 0 if unknown (imports, edits).
+    uint64_t Key() const {
+        return m_Cache->key.load(std::memory_order_acquire);
+    }
+    /// Tag the shape with its structural key unless it already has one.
+    void SetKey(uint64_t key) const {
+        uint64_t unset = 0;
+        m_Cache->key.compare_exchange_strong(unset, key, std::memory_order_acq_rel);
+    }
+
    private:
+    struct Cache {
+        std::once_flag boxOnce, obbOnce, validOnce, massOnce, countsOnce;
+        Bnd_Box box;
+        Bnd_OBB obb;
+        bool valid = false;
+        std::atomic<bool> validKnown{false};
+        std::atomic<uint64_t> key{0};
+        MassProps mass;
+        TopoCounts counts;
+    };
+
+    OcctShape(const TopoDS_Shape& s, std::shared_ptr<Cache> cache) : m_Shape(s), m_Cache(std::move(cache)) {
+    }
+
     TopoDS_Shape m_Shape;
+    std::shared_ptr<Cache> m_Cache;
 };
 
 }  // namespace ccad
@@ -1,4 +1,5 @@
 #pragma once
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepCheck_Analyzer.hxx>
 #include <ShapeFix_Shape.hxx>
 #include <TopoDS_Shape.hxx>
@@ -10,23 +11,67 @@
 
 namespace ccad {
 inline const OcctShape* ShapeAsOcct(const Shape& s) {
-    return dynamic_cast<const OcctShape*>(&const_cast<IShape&>(s.Get()));
+    return s ? dynamic_cast<const OcctShape*>(&s.Get()) : nullptr;
 }
 
 inline Shape WrapOcctShape(const TopoDS_Shape& s) {
     return Shape{std::make_unique<OcctShape>(std::move(s))};
 }
 
+/// Wrap the result of a trusted producer (primitive, successful boolean): it is never analysed.
+inline Shape WrapValidShape(const TopoDS_Shape& s) {
+    auto os = std::make_unique<OcctShape>(s);
+    os->MarkValid();
+    return Shape{std::move(os)};
+}
+
+/// Wrap a relocated copy of `from` (same TShape): it inherits the validity, if known.
+inline Shape WrapMovedShape(const TopoDS_Shape& s, const OcctShape& from) {
+    auto os = std::make_unique<OcctShape>(s);
+    if (from.ValidityKnown() && from.IsValid()) os->MarkValid();
+    return Shape{std::move(os)};
+}
+
 inline bool IsValid(const TopoDS_Shape& s) {
     BRepCheck_Analyzer ana(s);
     return ana.IsValid();
 }
 
+/// Repair `s` if it is invalid. The fix runs on a full copy: ShapeFix rewrites tolerances and curves in place,
+/// and the input may be shared through the operation cache.
 inline TopoDS_Shape FixIfNeeded(const TopoDS_Shape& s) {
     if (IsValid(s)) return s;
-    Handle(ShapeFix_Shape) fixer = new ShapeFix_Shape(s);
+    Handle(ShapeFix_Shape) fixer = new ShapeFix_Shape(BRepBuilderAPI_Copy(s).Shape());
+    fixer->Perform();
+    return fixer->Shape();
+}
+
+/// As above, but uses (and records) the shape's cached validity: clean shapes are analysed at most once.
+inline TopoDS_Shape FixIfNeeded(const OcctShape& s) {
+    if (s.IsValid()) return s.Occt();
+    Handle(ShapeFix_Shape) fixer = new ShapeFix_Shape(BRepBuilderAPI_Copy(s.Occt()).Shape());
     fixer->Perform();
     return fixer->Shape();
 }
 
+/**
+ * \brief Topology copy for algorithms which write into their input (fillet, chamfer and offset update
+ * tolerances and pcurves). Shapes are shared through the operation cache and between threads, so they must
+ * stay untouched; the surfaces and curves themselves are shared read-only.
+ */
+class PrivateCopy {
+   public:
+    explicit PrivateCopy(const TopoDS_Shape& s)
+        : m_Copy(s, /*copyGeom*/ Standard_False, /*copyMesh*/ Standard_False), m_Shape(m_Copy.Shape()) {}
+
+    const TopoDS_Shape& Shape() const { return m_Shape; }
+
+    /// Counterpart in the copy of `sub`, a sub-shape of the source (null stays null).
+    TopoDS_Shape Map(const TopoDS_Shape& sub) const { return sub.IsNull() ? sub : m_Copy.ModifiedShape(sub); }
+
+   private:
+    BRepBuilderAPI_Copy m_Copy;
+    TopoDS_Shape m_Shape;
+};
+
 }  // namespace ccad
@@ -0,0 +1,73 @@
+#pragma once
+/**
+ * @file Columns.hpp
+ * @brief Column filter kernels and set helpers shared by the edge and face selectors.
+ *
+ * Filters narrow a byte mask (1 = keep) with branch-free loops over contiguous arrays that the
+ * compiler can vectorize; the mask is packed into a BitSet once at the end.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ccad/select/BitSet.hpp"
+
+namespace ccad::select {
+
+/// keep[i] &= lo <= v[i] <= hi
+inline void KeepRange(uint8_t* keep, const double* v, size_t n, double lo, double hi) {
+    for (size_t i = 0; i < n; ++i) keep[i] &= static_cast<uint8_t>((v[i] >= lo) & (v[i] <= hi));
+}
+
+/// keep[i] &= |v[i] - ref| <= tol
+inline void KeepNear(uint8_t* keep, const double* v, size_t n, double ref, double tol) {
+    for (size_t i = 0; i < n; ++i) keep[i] &= static_cast<uint8_t>(std::abs(v[i] - ref) <= tol);
+}
+
+/// keep[i] &= |v[i]| >= minAbs
+inline void KeepAbsAtLeast(uint8_t* keep, const double* v, size_t n, double minAbs) {
+    for (size_t i = 0; i < n; ++i) keep[i] &= static_cast<uint8_t>(std::abs(v[i]) >= minAbs);
+}
+
+/// keep[i] &= (flag[i] != 0) == want
+inline void KeepFlag(uint8_t* keep, const uint8_t* flag, size_t n, bool want) {
+    const uint8_t w = want ? 1 : 0;
+    for (size_t i = 0; i < n; ++i) keep[i] &= static_cast<uint8_t>((flag[i] != 0) == w);
+}
+
+/// keep[i] &= v[i] == value
+inline void KeepEqual(uint8_t* keep, const uint8_t* v, size_t n, uint8_t value) {
+    for (size_t i = 0; i < n; ++i) keep[i] &= static_cast<uint8_t>(v[i] == value);
+}
+
+/// keep[i] &= i is one of `indices` (e.g. spatial-index candidates)
+inline void KeepOnly(uint8_t* keep, size_t n, const std::vector<size_t>& indices) {
+    std::vector<uint8_t> hit(n, 0);
+    for (size_t i : indices) hit[i] = 1;
+    for (size_t i = 0; i < n; ++i) keep[i] &= hit[i];
+}
+
+/**
+ * Make selection `a` compatible with `b` for word-wise set algebra.
+ * An empty (default) selection adopts b's table; selections over different shapes throw, even when
+ * they happen to have the same element count.
+ */
+template <typename Table>
+void AlignSets(std::shared_ptr<Table>& tableA, BitSet& a, const std::shared_ptr<Table>& tableB, const BitSet& b,
+               const char* what) {
+    if (!tableA) {
+        tableA = tableB;
+        a = BitSet(b.size());
+        return;
+    }
+    if (tableB && tableA != tableB && (a.size() != b.size() || !tableA->shape.IsSame(tableB->shape))) {
+        throw std::runtime_error(std::string(what) + ": sets belong to different shapes");
+    }
+}
+
+}  // namespace ccad::select
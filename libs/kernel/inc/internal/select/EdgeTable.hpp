@@ -0,0 +1,145 @@
+#pragma once
+/**
+ * @file EdgeTable.hpp
+ * @brief Per-shape edge index shared by EdgeSelector, EdgeSet and the edge features.
+ */
+
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Shape.hxx>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ccad/base/Bvh.hpp"
+#include "ccad/select/EdgeSelector.hpp"
+
+namespace ccad::select {
+
+/**
+ * Edge table with lazily computed attribute columns (structure of arrays).
+ *
+ * Construction only enumerates the edges. Each attribute group is computed for all edges
+ * the first time a filter needs it (once, in parallel); groups no filter touches are never built.
+ * Shared by the selector and every EdgeSet it produces.
+ */
+class EdgeTable {
+   public:
+    enum Attr { kCurve, kLength, kSample, kDihedral, kBounds, kBoxes, kAttrCount };
+
+    TopoDS_Shape shape;
+    double tol = 1e-6;
+    TopTools_IndexedMapOfShape edgeMap;  // index + 1 -> TopoDS_Edge
+
+    // kCurve
+    std::vector<uint8_t> circular;
+    std::vector<double> radius;
+    // kLength
+    std::vector<double> length;
+    // kSample: point and unit tangent at mid-parameter, one column per component
+    std::vector<double> px, py, pz;
+    std::vector<double> dx, dy, dz;
+    // kDihedral
+    std::vector<double> dihedral;
+    // kBounds
+    double bboxMin[3] = {0, 0, 0};
+    double bboxMax[3] = {0, 0, 0};
+    // kBoxes: per-edge bounding boxes and the BVH over them
+    std::vector<Bounds> boxes;
+    Bvh bvh;
+
+    explicit EdgeTable(const TopoDS_Shape& s, double tolerance) : shape(s), tol(tolerance) {
+        TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
+    }
+
+    size_t size() const {
+        return static_cast<size_t>(edgeMap.Extent());
+    }
+
+    const TopoDS_Edge& edge(size_t i) const {
+        return TopoDS::Edge(edgeMap.FindKey(static_cast<int>(i) + 1));
+    }
+
+    /// Point column for an axis.
+    const std::vector<double>& pointColumn(Axis a) const {
+        return a == Axis::X ? px : (a == Axis::Y ? py : pz);
+    }
+
+    /// Tangent column for an axis.
+    const std::vector<double>& dirColumn(Axis a) const {
+        return a == Axis::X ? dx : (a == Axis::Y ? dy : dz);
+    }
+
+    /// Compute an attribute group on first use; thread-safe.
+    void ensure(Attr a) {
+        std::call_once(m_Once[a], [this, a]() {
+            switch (a) {
+                case kCurve:
+                    computeCurve();
+                    break;
+                case kLength:
+                    computeLength();
+                    break;
+                case kSample:
+                    computeSample();
+                    break;
+                case kDihedral:
+                    computeDihedral();
+                    break;
+                case kBounds:
+                    computeBounds();
+                    break;
+                case kBoxes:
+                    computeBoxes();
+                    break;
+                default:
+                    break;
+            }
+        });
+    }
+
+    /// Fill the computed attributes of edge `i` into an EdgeRef.
+    EdgeRef ref(size_t i) const {
+        EdgeRef er;
+        er.index = i;
+        if (!circular.empty()) {
+            er.isCircular = circular[i] != 0;
+            er.radius = radius[i];
+        }
+        if (!length.empty()) er.length = length[i];
+        if (!px.empty()) {
+            er.anyPoint = glm::vec3(px[i], py[i], pz[i]);
+            er.approxDir = glm::vec3(dx[i], dy[i], dz[i]);
+        }
+        if (!dihedral.empty()) er.dihedralDeg = dihedral[i];
+        return er;
+    }
+
+   private:
+    void computeCurve();
+    void computeLength();
+    void computeSample();
+    void computeDihedral();
+    void computeBounds();
+    void computeBoxes();
+
+    std::once_flag m_Once[kAttrCount];
+};
+
+/**
+ * Edge map of `shape` for resolving the indices of `edges`.
+ *
+ * Returns the set's own table when it was built on this very shape (same TShape, location and
+ * orientation); otherwise the edges are mapped into `scratch`.
+ */
+inline const TopTools_IndexedMapOfShape& EdgeMapFor(const EdgeSet& edges, const TopoDS_Shape& shape,
+                                                    TopTools_IndexedMapOfShape& scratch) {
+    const auto& table = edges.table();
+    if (table && table->shape.IsEqual(shape)) return table->edgeMap;
+    TopExp::MapShapes(shape, TopAbs_EDGE, scratch);
+    return scratch;
+}
+
+}  // namespace ccad::select
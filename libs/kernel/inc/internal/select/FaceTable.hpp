@@ -0,0 +1,136 @@
+#pragma once
+/**
+ * @file FaceTable.hpp
+ * @brief Per-shape face index shared by FaceSelector, FaceSet and the face features.
+ */
+
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Shape.hxx>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ccad/base/Bvh.hpp"
+#include "ccad/select/FaceSelector.hpp"
+
+namespace ccad::select {
+
+/**
+ * Face table with lazily computed attribute columns (structure of arrays).
+ *
+ * Construction only enumerates the faces; each attribute group is computed for all faces the
+ * first time a filter needs it (once, in parallel).
+ */
+class FaceTable {
+   public:
+    enum Attr { kSurface, kMass, kAdjacency, kBounds, kBoxes, kAttrCount };
+
+    TopoDS_Shape shape;
+    double tol = 1e-6;
+    TopTools_IndexedMapOfShape faceMap;  // index + 1 -> TopoDS_Face
+
+    // kSurface: FaceGeom as byte, outward normal at mid-UV per component
+    std::vector<uint8_t> geom;
+    std::vector<double> nx, ny, nz;
+    // kMass: area and centroid per component
+    std::vector<double> area;
+    std::vector<double> cx, cy, cz;
+    // kAdjacency: CSR neighbor lists, faces of adjOffsets[i]..adjOffsets[i+1] in adj
+    std::vector<size_t> adjOffsets;
+    std::vector<size_t> adj;
+    // kBounds
+    double bboxMin[3] = {0, 0, 0};
+    double bboxMax[3] = {0, 0, 0};
+    // kBoxes: per-face bounding boxes and the BVH over them
+    std::vector<Bounds> boxes;
+    Bvh bvh;
+
+    explicit FaceTable(const TopoDS_Shape& s, double tolerance) : shape(s), tol(tolerance) {
+        TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    }
+
+    size_t size() const {
+        return static_cast<size_t>(faceMap.Extent());
+    }
+
+    const TopoDS_Face& face(size_t i) const {
+        return TopoDS::Face(faceMap.FindKey(static_cast<int>(i) + 1));
+    }
+
+    const std::vector<double>& normalColumn(Axis a) const {
+        return a == Axis::X ? nx : (a == Axis::Y ? ny : nz);
+    }
+
+    const std::vector<double>& centroidColumn(Axis a) const {
+        return a == Axis::X ? cx : (a == Axis::Y ? cy : cz);
+    }
+
+    /// Compute an attribute group on first use; thread-safe.
+    void ensure(Attr a) {
+        std::call_once(m_Once[a], [this, a]() {
+            switch (a) {
+                case kSurface:
+                    computeSurface();
+                    break;
+                case kMass:
+                    computeMass();
+                    break;
+                case kAdjacency:
+                    computeAdjacency();
+                    break;
+                case kBounds:
+                    computeBounds();
+                    break;
+                case kBoxes:
+                    computeBoxes();
+                    break;
+                default:
+                    break;
+            }
+        });
+    }
+
+    /// Fill the computed attributes of face `i` into a FaceRef.
+    FaceRef ref(size_t i) const {
+        FaceRef fr;
+        fr.index = i;
+        if (!geom.empty()) {
+            fr.geom = static_cast<FaceGeom>(geom[i]);
+            fr.normal = glm::vec3(nx[i], ny[i], nz[i]);
+        }
+        if (!area.empty()) {
+            fr.area = area[i];
+            fr.centroid = glm::vec3(cx[i], cy[i], cz[i]);
+        }
+        if (!adjOffsets.empty()) fr.neighbors.assign(adj.begin() + adjOffsets[i], adj.begin() + adjOffsets[i + 1]);
+        return fr;
+    }
+
+   private:
+    void computeSurface();
+    void computeMass();
+    void computeAdjacency();
+    void computeBounds();
+    void computeBoxes();
+
+    std::once_flag m_Once[kAttrCount];
+};
+
+/**
+ * Face map of `shape` for resolving the indices of `faces`.
+ *
+ * Returns the set's own table when it was built on this very shape (same TShape, location and
+ * orientation); otherwise the faces are mapped into `scratch`.
+ */
+inline const TopTools_IndexedMapOfShape& FaceMapFor(const FaceSet& faces, const TopoDS_Shape& shape,
+                                                    TopTools_IndexedMapOfShape& scratch) {
+    const auto& table = faces.table();
+    if (table && table->shape.IsEqual(shape)) return table->faceMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, scratch);
+    return scratch;
+}
+
+}  // namespace ccad::select
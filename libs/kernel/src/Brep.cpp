@@ -0,0 +1,31 @@
+#include <BinTools.hxx>
+#include <TopoDS_Shape.hxx>
+#include <ccad/base/Logger.hpp>
+#include <ccad/io/Brep.hpp>
+
+#include "internal/geom/ShapeHelper.hpp"
+
+namespace ccad::io {
+
+bool SaveBREP(const Shape& shape, const std::string& path) {
+    auto s = ShapeAsOcct(shape);
+    if (!s) throw std::runtime_error("SaveBREP: non-OCCT shape implementation");
+
+    // Triangulations are not stored: meshes are cached separately with their own parameters
+    if (BinTools::Write(s->Occt(), path.c_str(), /*theWithTriangles*/ false, /*theWithNormals*/ false,
+                        BinTools_FormatVersion_CURRENT)) {
+        return true;
+    }
+    LOG(ERROR) << "Failed to write BREP: " << path;
+    return false;
+}
+
+std::optional<Shape> LoadBREP(const std::string& path) {
+    TopoDS_Shape shape;
+    if (!BinTools::Read(shape, path.c_str()) || shape.IsNull()) {
+        return std::nullopt;
+    }
+    return WrapOcctShape(shape);
+}
+
+}  // namespace ccad::io
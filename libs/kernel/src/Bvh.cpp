@@ -0,0 +1,165 @@
+#include "ccad/base/Bvh.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ccad {
+
+namespace {
+
+constexpr uint32_t kLeafSize = 4;
+
+double Get(const Vec3& v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+void Grow(Bounds& acc, const Bounds& b) {
+    acc.min = {std::min(acc.min.x, b.min.x), std::min(acc.min.y, b.min.y), std::min(acc.min.z, b.min.z)};
+    acc.max = {std::max(acc.max.x, b.max.x), std::max(acc.max.y, b.max.y), std::max(acc.max.z, b.max.z)};
+}
+
+Bounds EmptyBounds() {
+    const double inf = std::numeric_limits<double>::infinity();
+    return Bounds{{inf, inf, inf}, {-inf, -inf, -inf}};
+}
+
+bool Overlaps(const Bounds& a, const Bounds& b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y &&
+           a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+double DistanceSq(const Bounds& b, const Vec3& p) {
+    const double dx = std::max({b.min.x - p.x, 0.0, p.x - b.max.x});
+    const double dy = std::max({b.min.y - p.y, 0.0, p.y - b.max.y});
+    const double dz = std::max({b.min.z - p.z, 0.0, p.z - b.max.z});
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/// Slab test; returns the entry parameter or a negative value on a miss.
+double RayEnter(const Bounds& b, const Vec3& o, const Vec3& inv, double maxT) {
+    double t0 = 0.0, t1 = maxT;
+    for (int a = 0; a < 3; ++a) {
+        const double lo = (Get(b.min, a) - Get(o, a)) * Get(inv, a);
+        const double hi = (Get(b.max, a) - Get(o, a)) * Get(inv, a);
+        // NaN (0 * inf) means the ray runs inside the slab plane: no constraint
+        if (std::isnan(lo) || std::isnan(hi)) continue;
+        t0 = std::max(t0, std::min(lo, hi));
+        t1 = std::min(t1, std::max(lo, hi));
+        if (t0 > t1) return -1.0;
+    }
+    return t0;
+}
+
+}  // namespace
+
+Bvh::Bvh(const std::vector<Bounds>& boxes) : m_Boxes(boxes), m_ItemCount(boxes.size()) {
+    std::vector<Vec3> centers(boxes.size());
+    m_Items.reserve(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        if (!boxes[i].IsValid()) continue;
+        centers[i] = boxes[i].Center();
+        m_Items.push_back(static_cast<uint32_t>(i));
+    }
+    if (m_Items.empty()) return;
+    m_Nodes.reserve(2 * m_Items.size() / kLeafSize + 1);
+    build(centers, 0, static_cast<uint32_t>(m_Items.size()));
+}
+
+uint32_t Bvh::build(const std::vector<Vec3>& centers, uint32_t begin, uint32_t end) {
+    const uint32_t node = static_cast<uint32_t>(m_Nodes.size());
+    m_Nodes.push_back({});
+
+    Bounds box = EmptyBounds();
+    Bounds cbox = EmptyBounds();
+    for (uint32_t i = begin; i < end; ++i) {
+        Grow(box, m_Boxes[m_Items[i]]);
+        const Vec3& c = centers[m_Items[i]];
+        Grow(cbox, Bounds{c, c});
+    }
+    m_Nodes[node].box = box;
+
+    if (end - begin <= kLeafSize) {
+        m_Nodes[node].first = begin;
+        m_Nodes[node].count = end - begin;
+        return node;
+    }
+
+    // median split along the longest axis of the centers
+    const Vec3 ext = cbox.Size();
+    const int axis = (ext.x >= ext.y && ext.x >= ext.z) ? 0 : (ext.y >= ext.z ? 1 : 2);
+    const uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(m_Items.begin() + begin, m_Items.begin() + mid, m_Items.begin() + end,
+                     [&](uint32_t a, uint32_t b) { return Get(centers[a], axis) < Get(centers[b], axis); });
+
+    build(centers, begin, mid);  // left child is node + 1
+    const uint32_t right = build(centers, mid, end);
+    m_Nodes[node].first = right;
+    return node;
+}
+
+std::vector<size_t> Bvh::Overlapping(const Bounds& query) const {
+    std::vector<size_t> out;
+    if (m_Nodes.empty()) return out;
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const Node& n = m_Nodes[stack.back()];
+        const uint32_t idx = stack.back();
+        stack.pop_back();
+        if (!Overlaps(n.box, query)) continue;
+        if (n.count) {
+            for (uint32_t i = n.first; i < n.first + n.count; ++i)
+                if (Overlaps(m_Boxes[m_Items[i]], query)) out.push_back(m_Items[i]);
+        } else {
+            stack.push_back(idx + 1);
+            stack.push_back(n.first);
+        }
+    }
+    return out;
+}
+
+std::vector<size_t> Bvh::Near(const Vec3& p, double radius) const {
+    std::vector<size_t> out;
+    if (m_Nodes.empty()) return out;
+    const double r2 = radius * radius;
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const uint32_t idx = stack.back();
+        const Node& n = m_Nodes[idx];
+        stack.pop_back();
+        if (DistanceSq(n.box, p) > r2) continue;
+        if (n.count) {
+            for (uint32_t i = n.first; i < n.first + n.count; ++i)
+                if (DistanceSq(m_Boxes[m_Items[i]], p) <= r2) out.push_back(m_Items[i]);
+        } else {
+            stack.push_back(idx + 1);
+            stack.push_back(n.first);
+        }
+    }
+    return out;
+}
+
+std::vector<std::pair<size_t, double>> Bvh::Ray(const Vec3& origin, const Vec3& dir, double maxT) const {
+    std::vector<std::pair<size_t, double>> out;
+    if (m_Nodes.empty()) return out;
+    const Vec3 inv{1.0 / dir.x, 1.0 / dir.y, 1.0 / dir.z};
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const uint32_t idx = stack.back();
+        const Node& n = m_Nodes[idx];
+        stack.pop_back();
+        if (RayEnter(n.box, origin, inv, maxT) < 0.0) continue;
+        if (n.count) {
+            for (uint32_t i = n.first; i < n.first + n.count; ++i) {
+                const double t = RayEnter(m_Boxes[m_Items[i]], origin, inv, maxT);
+                if (t >= 0.0) out.emplace_back(m_Items[i], t);
+            }
+        } else {
+            stack.push_back(idx + 1);
+            stack.push_back(n.first);
+        }
+    }
+    std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+    return out;
+}
+
+}  // namespace ccad
@@ -22,66 +22,72 @@
 #include "ccad/base/Status.hpp"
 #include "ccad/construct/Revolve.hpp"
 #include "ccad/sketch/SketchProfiles.hpp"
+#include "internal/OpCache.hpp"
+#include "internal/Progress.hpp"
 #include "internal/geom/ShapeHelper.hpp"
+#include "internal/select/EdgeTable.hpp"
 
 namespace ccad::feature {
 
 Shape ChamferAll(const Shape& s, double distanceMm) {
-    if (distanceMm <= 0.0) throw Exception("Distance must be > 0", Status::ERROR_OCCT);
-    auto os = ShapeAsOcct(s);
+    return Memoize(OpKey("ChamferAll").Input(s).Param(distanceMm), [&]() {
+        if (distanceMm <= 0.0) throw Exception("Distance must be > 0", Status::ERROR_OCCT);
+        auto os = ShapeAsOcct(s);
+        if (!os) throw std::runtime_error("Chamfer: non-OCCT shape implementation");
 
-    auto occtShape = os->Occt();
-
-    if (!os) throw std::runtime_error("Fillet: non-OCCT shape implementation");
-
-    try {
-        TopoDS_Shape in = ccad::FixIfNeeded(occtShape);
-
-        BRepFilletAPI_MakeChamfer mk(in);
-
-        // Edge → Faces-Mapping
-        TopTools_IndexedDataMapOfShapeListOfShape edge2faces;
-        TopExp::MapShapesAndAncestors(in, TopAbs_EDGE, TopAbs_FACE, edge2faces);
-
-        int added = 0;
-        for (int i = 1; i <= edge2faces.Extent(); ++i) {
-            const TopoDS_Edge& e = TopoDS::Edge(edge2faces.FindKey(i));
-            const TopTools_ListOfShape& faces = edge2faces.FindFromIndex(i);
-            if (!faces.IsEmpty()) {
-                const TopoDS_Face& f = TopoDS::Face(faces.First());
-                try {
-                    mk.Add(distanceMm, distanceMm, e, f);
-                    ++added;
-                } catch (const Standard_Failure& e) {
-                    LOG(ERROR) << "[chamfer] Problem during adding: " << e.GetMessageString();
+        try {
+            const PrivateCopy copy(ccad::FixIfNeeded(*os));
+            const TopoDS_Shape& in = copy.Shape();
+
+            BRepFilletAPI_MakeChamfer mk(in);
+
+            // Edge → Faces-Mapping
+            TopTools_IndexedDataMapOfShapeListOfShape edge2faces;
+            TopExp::MapShapesAndAncestors(in, TopAbs_EDGE, TopAbs_FACE, edge2faces);
+
+            int added = 0;
+            for (int i = 1; i <= edge2faces.Extent(); ++i) {
+                const TopoDS_Edge& e = TopoDS::Edge(edge2faces.FindKey(i));
+                const TopTools_ListOfShape& faces = edge2faces.FindFromIndex(i);
+                if (!faces.IsEmpty()) {
+                    const TopoDS_Face& f = TopoDS::Face(faces.First());
+                    try {
+                        mk.Add(distanceMm, distanceMm, e, f);
+                        ++added;
+                    } catch (const Standard_Failure& e) {
+                        LOG(ERROR) << "[chamfer] Problem during adding: " << e.GetMessageString();
+                    }
                 }
             }
-        }
 
-        if (added == 0) {
-            LOG(ERROR) << "[chamfer] no applicable edges, returning original.\n";
-            return s;
-        }
+            if (added == 0) {
+                LOG(ERROR) << "[chamfer] no applicable edges, returning original.\n";
+                return s;
+            }
 
-        mk.Build();
-        if (!mk.IsDone()) {
-            LOG(ERROR) << "[chamfer] mk.IsDone() == false, returning original.\n";
-            return s;
-        }
+            OperationProgress progress("Chamfer");
+            mk.Build(progress.Range());
+            progress.ThrowIfCancelled();
+            if (!mk.IsDone()) {
+                LOG(ERROR) << "[chamfer] mk.IsDone() == false, returning original.\n";
+                return s;
+            }
 
-        TopoDS_Shape out = mk.Shape();
-        if (out.IsNull()) {
-            LOG(ERROR) << "[chamfer] result is null, returning original.\n";
+            TopoDS_Shape out = mk.Shape();
+            if (out.IsNull()) {
+                LOG(ERROR) << "[chamfer] result is null, returning original.\n";
+                return s;
+            }
+            return WrapOcctShape(out);
+        } catch (const Standard_Failure& e) {
+            LOG(ERROR) << "[chamfer] OpenCascade error: " << e.GetMessageString() << "\n";
+            return s;
+        } catch (...) {
+            ThrowIfCancelled();
+            LOG(ERROR) << "[chamfer] unknown error.\n";
             return s;
         }
-        return WrapOcctShape(out);
-    } catch (const Standard_Failure& e) {
-        LOG(ERROR) << "[chamfer] OpenCascade error: " << e.GetMessageString() << "\n";
-        return s;
-    } catch (...) {
-        LOG(ERROR) << "[chamfer] unknown error.\n";
-        return s;
-    }
+    });
 }
 
 Shape ChamferCutterRadial(double diameter, const ChamferRadialSpec& spec) {
@@ -106,13 +112,6 @@ Shape ChamferCutterRadial(double diameter, const ChamferRadialSpec& spec) {
     return construct::RevolveZ(profile, 360);
 }
 
-/** Map all edges of a shape to a stable 1-based index. */
-static TopTools_IndexedMapOfShape BuildEdgeMap(const TopoDS_Shape& shape) {
-    TopTools_IndexedMapOfShape emap;
-    TopExp::MapShapes(shape, TopAbs_EDGE, emap);
-    return emap;
-}
-
 /** Resolve a zero-based EdgeRef.index to a TopoDS_Edge using an IndexedMap. */
 static TopoDS_Edge GetEdgeByIndex(const TopTools_IndexedMapOfShape& emap, std::size_t zeroBasedIndex) {
     Standard_Integer oneBased = static_cast<Standard_Integer>(zeroBasedIndex + 1);
@@ -137,49 +136,56 @@ static TopoDS_Shape EnsureFaceIfWire(const TopoDS_Shape& in) {
 }
 
 Shape Chamfer(const Shape& s, const select::EdgeSet& edgeSet, double distanceMm) {
-    if (distanceMm <= 0.0) return s;
-
-    auto os = ShapeAsOcct(s);
-    if (!os) throw std::runtime_error("Chamfer: non-OCCT shape implementation");
-    TopoDS_Shape shape = EnsureFaceIfWire(os->Occt());
-
-    // Pre-build maps for fast lookups
-    TopTools_IndexedMapOfShape edgeMap = BuildEdgeMap(shape);
-    TopTools_IndexedDataMapOfShapeListOfShape edge2faces = BuildEdgeToFaces(shape);
+    return Memoize(OpKey("Chamfer").Input(s).Param(edgeSet.bits()).Param(distanceMm), [&]() {
+        if (distanceMm <= 0.0) return s;
+
+        auto os = ShapeAsOcct(s);
+        if (!os) throw std::runtime_error("Chamfer: non-OCCT shape implementation");
+        const TopoDS_Shape& source = os->Occt();
+        const PrivateCopy copy(source);
+        TopoDS_Shape shape = EnsureFaceIfWire(copy.Shape());
+
+        // Pre-build maps for fast lookups; the selector's edge map is reused when it was built on the source
+        TopTools_IndexedMapOfShape scratch;
+        const TopTools_IndexedMapOfShape& edgeMap = select::EdgeMapFor(edgeSet, source, scratch);
+        TopTools_IndexedDataMapOfShapeListOfShape edge2faces = BuildEdgeToFaces(shape);
+
+        BRepFilletAPI_MakeChamfer mkChamfer(shape);
+
+        // Add a symmetric Distance/Distance chamfer for each selected edge.
+        for (size_t idx : edgeSet.indices()) {
+            TopoDS_Edge e;
+            try {
+                e = TopoDS::Edge(copy.Map(GetEdgeByIndex(edgeMap, idx)));
+            } catch (...) {
+                continue;  // skip invalid index
+            }
 
-    BRepFilletAPI_MakeChamfer mkChamfer(shape);
+            // Fetch an adjacent face; for solids there are usually 2, for open shells 1.
+            if (!edge2faces.Contains(e)) {
+                // No adjacent face information; skip this edge.
+                continue;
+            }
+            const TopTools_ListOfShape& lst = edge2faces.FindFromKey(e);
+            if (lst.IsEmpty()) {
+                continue;
+            }
+            // Use the first adjacent face (robust default).
+            TopoDS_Face f = TopoDS::Face(lst.First());
 
-    // Add a symmetric Distance/Distance chamfer for each selected edge.
-    for (const auto& er : edgeSet.items()) {
-        TopoDS_Edge e;
-        try {
-            e = GetEdgeByIndex(edgeMap, er.index);
-        } catch (...) {
-            continue;  // skip invalid index
+            // Symmetric D1=D2 chamfer
+            mkChamfer.Add(distanceMm, distanceMm, e, f);
         }
 
-        // Fetch an adjacent face; for solids there are usually 2, for open shells 1.
-        if (!edge2faces.Contains(e)) {
-            // No adjacent face information; skip this edge.
-            continue;
-        }
-        const TopTools_ListOfShape& lst = edge2faces.FindFromKey(e);
-        if (lst.IsEmpty()) {
-            continue;
+        OperationProgress progress("Chamfer");
+        mkChamfer.Build(progress.Range());
+        progress.ThrowIfCancelled();
+        if (!mkChamfer.IsDone()) {
+            // Graceful fallback: return original shape on failure
+            return s;
         }
-        // Use the first adjacent face (robust default).
-        TopoDS_Face f = TopoDS::Face(lst.First());
-
-        // Symmetric D1=D2 chamfer
-        mkChamfer.Add(distanceMm, distanceMm, e, f);
-    }
-
-    mkChamfer.Build();
-    if (!mkChamfer.IsDone()) {
-        // Graceful fallback: return original shape on failure
-        return s;
-    }
-    return WrapOcctShape(mkChamfer.Shape());
+        return WrapOcctShape(mkChamfer.Shape());
+    });
 }
 
 }  // namespace ccad::feature
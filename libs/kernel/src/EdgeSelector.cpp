@@ -8,12 +8,16 @@
 #include <algorithm>
 #include <ccad/base/Logger.hpp>
 #include <cmath>
-#include <unordered_set>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
 
 // -------- internal OCCT bridge headers  --------
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAdaptor_Surface.hxx>
 #include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
 #include <BRepGProp.hxx>
 #include <BRepLProp_CLProps.hxx>
 #include <BRep_Tool.hxx>
@@ -28,158 +32,218 @@
 #include <TopTools_ListIteratorOfListOfShape.hxx>
 #include <TopTools_ListOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Vertex.hxx>
 #include <gp.hxx>
 #include <gp_Dir.hxx>
 #include <gp_Pnt.hxx>
 
 #include "internal/MathHelper.hpp"
+#include "internal/ThreadPool.hpp"
 #include "internal/geom/ShapeHelper.hpp"
+#include "internal/select/Columns.hpp"
+#include "internal/select/EdgeTable.hpp"
 
 namespace ccad::select {
 
-struct EdgeSelector::Impl {
-    // ownership is shared through EdgeSelector copies
-    TopoDS_Shape shape;
-    double tol = 1e-6;
-
-    // map edges -> index + attributes
-    std::vector<EdgeRef> edges;          // index == position
-    TopTools_IndexedMapOfShape edgeMap;  // to get back TopoDS_Edge if needed
-    glm::vec3 bboxMin{}, bboxMax{};
-
-    explicit Impl(const TopoDS_Shape& s, double tolerance) : shape(s), tol(tolerance) {
-        buildCache();
-    }
-
-    void buildCache() {
-        // 1) gather edges
-        TopExp::MapShapes(shape, TopAbs_EDGE, edgeMap);
-        edges.reserve(edgeMap.Extent());
-
-        // bbox of full shape
-        Bnd_Box bb;
-        BRepBndLib::Add(shape, bb, false);
-        Standard_Real xmin, ymin, zmin, xmax, ymax, zmax;
-        bb.Get(xmin, ymin, zmin, xmax, ymax, zmax);
-        bboxMin = {(float)xmin, (float)ymin, (float)zmin};
-        bboxMax = {(float)xmax, (float)ymax, (float)zmax};
-
-        // map edges -> adjacent faces (for dihedral)
-        TopTools_IndexedDataMapOfShapeListOfShape edge2faces;
-        TopExp::MapShapesAndAncestors(shape, TopAbs_EDGE, TopAbs_FACE, edge2faces);
-
-        // 2) compute attributes per edge
-        edges.resize(edgeMap.Extent());
-
-        for (int i = 1; i <= edgeMap.Extent(); ++i) {
-            const TopoDS_Edge& E = TopoDS::Edge(edgeMap.FindKey(i));
-            EdgeRef er;
-            er.index = static_cast<size_t>(i - 1);
+// ---------- EdgeTable columns ----------
+static constexpr size_t kGrain = 64;
+
+void EdgeTable::computeCurve() {
+    const size_t n = size();
+    circular.assign(n, 0);
+    radius.assign(n, 0.0);
+    ParallelFor(0, n, kGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            BRepAdaptor_Curve c(edge(i));
+            // circle and arc are both circular
+            if (c.GetType() == GeomAbs_Circle) {
+                circular[i] = 1;
+                radius[i] = c.Circle().Radius();
+            }
+        }
+    });
+}
 
-            // length
+void EdgeTable::computeLength() {
+    const size_t n = size();
+    length.assign(n, 0.0);
+    ParallelFor(0, n, kGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
             GProp_GProps lp;
-            BRepGProp::LinearProperties(E, lp);
-            er.length = lp.Mass();
+            BRepGProp::LinearProperties(edge(i), lp);
+            length[i] = lp.Mass();
+        }
+    });
+}
 
-            BRepAdaptor_Curve c(E);
-            const GeomAbs_CurveType ct = c.GetType();
-            const Standard_Real f = c.FirstParameter();
-            const Standard_Real l = c.LastParameter();
-            const Standard_Real mid = 0.5 * (f + l);
+void EdgeTable::computeSample() {
+    const size_t n = size();
+    px.assign(n, 0.0);
+    py.assign(n, 0.0);
+    pz.assign(n, 0.0);
+    dx.assign(n, 1.0);
+    dy.assign(n, 0.0);
+    dz.assign(n, 0.0);
+    ParallelFor(0, n, kGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            BRepAdaptor_Curve c(edge(i));
+            const Standard_Real mid = 0.5 * (c.FirstParameter() + c.LastParameter());
 
             gp_Pnt Pm(0, 0, 0);
             gp_Dir Tg(1, 0, 0);
-
             try {
                 BRepLProp_CLProps lprop(c, /*DerivativeOrder*/ 1, /*Tol*/ tol);
                 lprop.SetParameter(mid);
-
                 Pm = lprop.Value();
-
-                if (lprop.IsTangentDefined()) {
-                    gp_Dir t;
-                    lprop.Tangent(t);
-                    Tg = t;
-                }
+                if (lprop.IsTangentDefined()) lprop.Tangent(Tg);
             } catch (...) {
                 LOG(ERROR) << "Fallback for midpoint";
-                // Fallback
-                Pm = c.Value(mid);
-                // Tg bleibt default (1,0,0)
+                Pm = c.Value(mid);  // tangent stays (1,0,0)
             }
+            px[i] = Pm.X();
+            py[i] = Pm.Y();
+            pz[i] = Pm.Z();
+            dx[i] = Tg.X();
+            dy[i] = Tg.Y();
+            dz[i] = Tg.Z();
+        }
+    });
+}
 
-            er.anyPoint = ToGlm(Pm);
-            er.approxDir = ToGlm(Tg);
-
-            // Kreis/Arc → both are circular
-            er.isCircular = (ct == GeomAbs_Circle);
-            er.radius = er.isCircular ? c.Circle().Radius() : 0.0;
-
-            // Dihedral
-            er.dihedralDeg = 180.0;
-            if (edge2faces.Contains(E)) {
-                const TopTools_ListOfShape& lst = edge2faces.FindFromKey(E);
-                if (lst.Extent() >= 2) {
-                    TopTools_ListIteratorOfListOfShape it(lst);
-                    const TopoDS_Face F1 = TopoDS::Face(it.Value());
-                    it.Next();
-                    const TopoDS_Face F2 = TopoDS::Face(it.Value());
-
-                    BRepAdaptor_Surface s1(F1), s2(F2);
-                    if (s1.GetType() == GeomAbs_Plane && s2.GetType() == GeomAbs_Plane) {
-                        gp_Dir n1 = s1.Plane().Axis().Direction();
-                        gp_Dir n2 = s2.Plane().Axis().Direction();
-                        double a = CalculateAngleInDeg(n1, n2);
-                        if (a > 180.0) a = 360.0 - a;
-                        er.dihedralDeg = a;
-                    }
-                }
+void EdgeTable::computeDihedral() {
+    const size_t n = size();
+    dihedral.assign(n, 180.0);
+
+    // map edges -> adjacent faces
+    TopTools_IndexedDataMapOfShapeListOfShape edge2faces;
+    TopExp::MapShapesAndAncestors(shape, TopAbs_EDGE, TopAbs_FACE, edge2faces);
+
+    ParallelFor(0, n, kGrain, [this, &edge2faces](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const TopoDS_Edge& E = edge(i);
+            if (!edge2faces.Contains(E)) continue;
+            const TopTools_ListOfShape& lst = edge2faces.FindFromKey(E);
+            if (lst.Extent() < 2) continue;
+
+            TopTools_ListIteratorOfListOfShape it(lst);
+            const TopoDS_Face F1 = TopoDS::Face(it.Value());
+            it.Next();
+            const TopoDS_Face F2 = TopoDS::Face(it.Value());
+
+            BRepAdaptor_Surface s1(F1), s2(F2);
+            if (s1.GetType() == GeomAbs_Plane && s2.GetType() == GeomAbs_Plane) {
+                gp_Dir n1 = s1.Plane().Axis().Direction();
+                gp_Dir n2 = s2.Plane().Axis().Direction();
+                double a = CalculateAngleInDeg(n1, n2);
+                if (a > 180.0) a = 360.0 - a;
+                dihedral[i] = a;
             }
-
-            edges[er.index] = er;
         }
+    });
+}
+
+void EdgeTable::computeBounds() {
+    Bnd_Box bb;
+    BRepBndLib::Add(shape, bb, false);
+    bb.Get(bboxMin[0], bboxMin[1], bboxMin[2], bboxMax[0], bboxMax[1], bboxMax[2]);
+    // Get() widens the box by the shape tolerance (the gap); box sides are matched against the geometry
+    const double gap = bb.GetGap();
+    for (int k = 0; k < 3; ++k) {
+        bboxMin[k] += gap;
+        bboxMax[k] -= gap;
     }
-};
+}
+
+void EdgeTable::computeBoxes() {
+    const size_t n = size();
+    boxes.assign(n, Bounds{{1, 1, 1}, {0, 0, 0}});  // invalid until computed
+    ParallelFor(0, n, kGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Bnd_Box bb;
+            BRepBndLib::Add(edge(i), bb, false);
+            if (bb.IsVoid()) continue;
+            double x0, y0, z0, x1, y1, z1;
+            bb.Get(x0, y0, z0, x1, y1, z1);
+            boxes[i] = Bounds{{x0, y0, z0}, {x1, y1, z1}};
+        }
+    });
+    bvh = Bvh(boxes);
+}
 
 // ---------- EdgeSet ops ----------
-static std::unordered_set<size_t> indexSet(const EdgeSet& s) {
-    std::unordered_set<size_t> out;
-    out.reserve(s.size());
-    for (auto& e : s.items()) out.insert(e.index);
+std::vector<EdgeRef> EdgeSet::items() const {
+    std::vector<EdgeRef> out;
+    if (!m_table) return out;
+    for (auto a : {EdgeTable::kCurve, EdgeTable::kLength, EdgeTable::kSample, EdgeTable::kDihedral}) m_table->ensure(a);
+    out.reserve(m_bits.count());
+    m_bits.forEach([&](size_t i) { out.push_back(m_table->ref(i)); });
     return out;
 }
 
 EdgeSet& EdgeSet::unite(const EdgeSet& b) {
-    auto is = indexSet(*this);
-    for (auto& e : b.m_items)
-        if (is.insert(e.index).second) m_items.push_back(e);
+    if (!b.m_table) return *this;
+    AlignSets(m_table, m_bits, b.m_table, b.m_bits, "EdgeSet");
+    m_bits |= b.m_bits;
     return *this;
 }
 
 EdgeSet& EdgeSet::intersect(const EdgeSet& b) {
-    auto ib = indexSet(b);
-    std::vector<EdgeRef> out;
-    out.reserve(std::min(m_items.size(), b.m_items.size()));
-    for (auto& e : m_items)
-        if (ib.count(e.index)) out.push_back(e);
-    m_items.swap(out);
+    if (!b.m_table) {
+        m_bits = BitSet(m_bits.size());
+        return *this;
+    }
+    AlignSets(m_table, m_bits, b.m_table, b.m_bits, "EdgeSet");
+    m_bits &= b.m_bits;
     return *this;
 }
 
 EdgeSet& EdgeSet::subtract(const EdgeSet& b) {
-    auto ib = indexSet(b);
-    std::vector<EdgeRef> out;
-    out.reserve(m_items.size());
-    for (auto& e : m_items)
-        if (!ib.count(e.index)) out.push_back(e);
-    m_items.swap(out);
+    if (!b.m_table || !m_table) return *this;
+    AlignSets(m_table, m_bits, b.m_table, b.m_bits, "EdgeSet");
+    m_bits.andNot(b.m_bits);
     return *this;
 }
 
 // ---------- EdgeSelector API ----------
 EdgeSelector EdgeSelector::FromShape(const ccad::Shape& s, double tolerance) {
     auto occ = ShapeAsOcct(s);
-    return EdgeSelector(std::make_shared<Impl>(occ->Occt(), tolerance));
+    return EdgeSelector(std::make_shared<EdgeTable>(occ->Occt(), tolerance));
+}
+
+// ---------- EdgeSelectorCache ----------
+EdgeSelector EdgeSelectorCache::FromShape(const ccad::Shape& s, double tolerance) {
+    auto occ = ShapeAsOcct(s);
+    const TopoDS_Shape& shape = occ->Occt();
+    const void* key = shape.TShape().get();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto range = m_Entries.equal_range(key);
+    for (auto it = range.first; it != range.second;) {
+        auto table = it->second.table.lock();
+        if (!table) {
+            it = m_Entries.erase(it);
+            continue;
+        }
+        if (it->second.tolerance == tolerance && table->shape.IsEqual(shape)) return EdgeSelector(table);
+        ++it;
+    }
+
+    auto table = std::make_shared<EdgeTable>(shape, tolerance);
+    m_Entries.emplace(key, Entry{table, tolerance});
+    return EdgeSelector(table);
+}
+
+void EdgeSelectorCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.clear();
+}
+
+size_t EdgeSelectorCache::Size() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    size_t n = 0;
+    for (const auto& entry : m_Entries)
+        if (!entry.second.table.expired()) ++n;
+    return n;
 }
 
 EdgeSelector& EdgeSelector::geom(EdgeGeom g) {
@@ -222,109 +286,94 @@ EdgeSelector& EdgeSelector::insideAABB(const glm::vec3& minP, const glm::vec3& m
     return *this;
 }
 
-EdgeSet EdgeSelector::collect() const {
-    EdgeSet out;
-    out.m_items.reserve(m_impl->edges.size());
-
-    auto pass = [&](const EdgeRef& e) -> bool {
-        // geom
-        if (m_filters.geom) {
-            switch (*m_filters.geom) {
-                case EdgeGeom::Any:
-                    break;
-                case EdgeGeom::Line:
-                    if (e.isCircular) return false;
-                    break;
-                case EdgeGeom::Circle:
-                    if (!e.isCircular) return false;
-                    // (note: true circles vs arcs both are "circular" here)
-                    break;
-                case EdgeGeom::Arc:
-                    if (!e.isCircular) return false;
-                    break;
-            }
-        }
-        // length
-        if (m_filters.length) {
-            if (e.length < m_filters.length->min || e.length > m_filters.length->max) return false;
-        }
-        // radius
-        if (m_filters.radius) {
-            if (!e.isCircular) return false;
-            if (e.radius < m_filters.radius->min || e.radius > m_filters.radius->max) return false;
-        }
-        // dihedral
-        if (m_filters.dihedral) {
-            if (e.dihedralDeg < m_filters.dihedral->minDeg || e.dihedralDeg > m_filters.dihedral->maxDeg) return false;
-        }
-        // parallel to axis
-        if (m_filters.parallelAxisTolDeg) {
-            const auto [ax, tolDeg] = *m_filters.parallelAxisTolDeg;
-
-            const glm::vec3 axis = GetAxisDirection(ax);
-            const glm::vec3 d = glm::normalize(e.approxDir);
-
-            const float cosTol = std::cos(glm::radians(static_cast<float>(tolDeg)));
-            const float c = std::abs(glm::dot(d, axis));
+EdgeSelector& EdgeSelector::nearPoint(const glm::vec3& p, double radius) {
+    m_filters.nearPoint = std::make_pair(p, radius);
+    return *this;
+}
 
-            if (c < cosTol) return false;
-        }
-        // near plane axis=value
-        if (m_filters.planeAxisValTol) {
-            auto [ax, val, tol] = *m_filters.planeAxisValTol;
-            double coord = 0.0;
-            switch (ax) {
-                case Axis::X:
-                    coord = e.anyPoint.x;
-                    break;
-                case Axis::Y:
-                    coord = e.anyPoint.y;
-                    break;
-                case Axis::Z:
-                    coord = e.anyPoint.z;
-                    break;
-            }
-            if (std::abs(coord - val) > tol) return false;
-        }
-        // on box side
-        if (m_filters.boxSideTol) {
-            auto [side, tol] = *m_filters.boxSideTol;
-            switch (side) {
-                case BoxSide::XMin:
-                    if (std::abs(e.anyPoint.x - m_impl->bboxMin.x) > tol) return false;
-                    break;
-                case BoxSide::XMax:
-                    if (std::abs(e.anyPoint.x - m_impl->bboxMax.x) > tol) return false;
-                    break;
-                case BoxSide::YMin:
-                    if (std::abs(e.anyPoint.y - m_impl->bboxMin.y) > tol) return false;
-                    break;
-                case BoxSide::YMax:
-                    if (std::abs(e.anyPoint.y - m_impl->bboxMax.y) > tol) return false;
-                    break;
-                case BoxSide::ZMin:
-                    if (std::abs(e.anyPoint.z - m_impl->bboxMin.z) > tol) return false;
-                    break;
-                case BoxSide::ZMax:
-                    if (std::abs(e.anyPoint.z - m_impl->bboxMax.z) > tol) return false;
-                    break;
-            }
-        }
-        // inside AABB
-        if (m_filters.aabb) {
-            const auto& minP = m_filters.aabb->first;
-            const auto& maxP = m_filters.aabb->second;
-            const glm::vec3& p = e.anyPoint;
-            if (p.x < minP.x || p.y < minP.y || p.z < minP.z) return false;
-            if (p.x > maxP.x || p.y > maxP.y || p.z > maxP.z) return false;
+EdgeSet EdgeSelector::collect() const {
+    // Build only the attribute groups the active filters read
+    EdgeTable& t = *m_table;
+    const bool needCurve = (m_filters.geom && *m_filters.geom != EdgeGeom::Any) || m_filters.radius.has_value();
+    const bool needSample = m_filters.parallelAxisTolDeg || m_filters.planeAxisValTol || m_filters.boxSideTol ||
+                            m_filters.aabb;
+    if (needCurve) t.ensure(EdgeTable::kCurve);
+    if (m_filters.length) t.ensure(EdgeTable::kLength);
+    if (needSample) t.ensure(EdgeTable::kSample);
+    if (m_filters.dihedral) t.ensure(EdgeTable::kDihedral);
+    if (m_filters.boxSideTol) t.ensure(EdgeTable::kBounds);
+    if (m_filters.aabb || m_filters.nearPoint) t.ensure(EdgeTable::kBoxes);
+
+    const size_t n = t.size();
+    std::vector<uint8_t> keep(n, 1);
+    uint8_t* k = keep.data();
+
+    // spatial filters start from the BVH candidates instead of scanning every edge
+    if (m_filters.aabb) {
+        const auto& minP = m_filters.aabb->first;
+        const auto& maxP = m_filters.aabb->second;
+        KeepOnly(k, n, t.bvh.Overlapping(Bounds{{minP.x, minP.y, minP.z}, {maxP.x, maxP.y, maxP.z}}));
+    }
+    if (m_filters.nearPoint) {
+        const auto& [p, radius] = *m_filters.nearPoint;
+        std::vector<size_t> hits;
+        const TopoDS_Vertex V = BRepBuilderAPI_MakeVertex(gp_Pnt(p.x, p.y, p.z));
+        for (size_t i : t.bvh.Near(Vec3(p.x, p.y, p.z), radius)) {
+            if (!k[i]) continue;
+            BRepExtrema_DistShapeShape dist(V, t.edge(i));
+            if (dist.IsDone() && dist.Value() <= radius) hits.push_back(i);
         }
+        KeepOnly(k, n, hits);
+    }
 
-        return true;
-    };
-
-    for (const auto& e : m_impl->edges) {
-        if (pass(e)) out.m_items.push_back(e);
+    // geom: circles and arcs are both "circular"; Line means anything else
+    if (m_filters.geom && *m_filters.geom != EdgeGeom::Any) {
+        KeepFlag(k, t.circular.data(), n, *m_filters.geom != EdgeGeom::Line);
+    }
+    if (m_filters.length) {
+        KeepRange(k, t.length.data(), n, m_filters.length->min, m_filters.length->max);
     }
+    if (m_filters.radius) {
+        KeepFlag(k, t.circular.data(), n, true);
+        KeepRange(k, t.radius.data(), n, m_filters.radius->min, m_filters.radius->max);
+    }
+    if (m_filters.dihedral) {
+        KeepRange(k, t.dihedral.data(), n, m_filters.dihedral->minDeg, m_filters.dihedral->maxDeg);
+    }
+    // parallel to axis: tangents are unit vectors, so |dot(d, axis)| is the axis component
+    if (m_filters.parallelAxisTolDeg) {
+        const auto [ax, tolDeg] = *m_filters.parallelAxisTolDeg;
+        const double cosTol = std::cos(DegToRad(tolDeg));
+        KeepAbsAtLeast(k, t.dirColumn(ax).data(), n, cosTol);
+    }
+    // near plane axis=value
+    if (m_filters.planeAxisValTol) {
+        const auto [ax, val, tol] = *m_filters.planeAxisValTol;
+        KeepNear(k, t.pointColumn(ax).data(), n, val, tol);
+    }
+    // on box side of the shape's bounding box
+    if (m_filters.boxSideTol) {
+        const auto [side, tol] = *m_filters.boxSideTol;
+        const Axis ax = (side == BoxSide::XMin || side == BoxSide::XMax)   ? Axis::X
+                        : (side == BoxSide::YMin || side == BoxSide::YMax) ? Axis::Y
+                                                                           : Axis::Z;
+        const bool isMin = side == BoxSide::XMin || side == BoxSide::YMin || side == BoxSide::ZMin;
+        const int c = static_cast<int>(ax);
+        KeepNear(k, t.pointColumn(ax).data(), n, isMin ? t.bboxMin[c] : t.bboxMax[c], tol);
+    }
+    // inside AABB
+    if (m_filters.aabb) {
+        const auto& minP = m_filters.aabb->first;
+        const auto& maxP = m_filters.aabb->second;
+        KeepRange(k, t.px.data(), n, minP.x, maxP.x);
+        KeepRange(k, t.py.data(), n, minP.y, maxP.y);
+        KeepRange(k, t.pz.data(), n, minP.z, maxP.z);
+    }
+
+    EdgeSet out;
+    out.m_table = m_table;
+    out.m_bits = BitSet(n);
+    out.m_bits.assignMask(k);
     return out;
 }
 
@@ -0,0 +1,96 @@
+#include "ccad/base/Execution.hpp"
+
+#include <OSD_Parallel.hxx>
+#include <OSD_ThreadPool.hxx>
+#include <Standard_Failure.hxx>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "ccad/base/Logger.hpp"
+#include "internal/Execution.hpp"
+#include "internal/ThreadPool.hpp"
+
+namespace ccad {
+
+static std::atomic<size_t> s_Workers{0};  // 0 until first use
+static std::atomic<size_t> s_Busy{0};     // threads in a WorkerScope plus leased workers
+static thread_local bool t_InScope = false;
+
+static size_t DefaultWorkerCount() {
+    if (const char* env = std::getenv(kJobsEnvVar)) {
+        char* end = nullptr;
+        const long n = std::strtol(env, &end, 10);
+        if (end != env && *end == '\0' && n > 0) return static_cast<size_t>(n);
+        LOG(WARN) << "Ignoring " << kJobsEnvVar << "=" << env << ": not a positive number";
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Size OCCT's default pool to the budget; OCCT's own threads are used even in TBB builds.
+static void ConfigureOcct(size_t workers) {
+    try {
+        OSD_Parallel::SetUseOcctThreads(true);
+        const Handle(OSD_ThreadPool)& pool = OSD_ThreadPool::DefaultPool();
+        pool->Init(static_cast<int>(workers));
+        pool->SetNbDefaultThreadsToLaunch(static_cast<int>(workers));
+    } catch (const Standard_Failure& e) {
+        LOG(WARN) << "Could not resize the OCCT thread pool: " << e.GetMessageString();
+    }
+}
+
+size_t WorkerCount() {
+    static std::once_flag once;
+    std::call_once(once, []() {
+        size_t expected = 0;
+        s_Workers.compare_exchange_strong(expected, DefaultWorkerCount());
+        ConfigureOcct(s_Workers.load());
+    });
+    return s_Workers.load(std::memory_order_relaxed);
+}
+
+void SetWorkerCount(size_t workers) {
+    if (workers == 0) workers = DefaultWorkerCount();
+    WorkerCount();  // apply the defaults once, so they cannot override this call later
+    if (s_Workers.exchange(workers) == workers) return;
+    ConfigureOcct(workers);
+    ThreadPool::Resize(workers);
+    LOG(INFO) << "Kernel worker budget: " << workers;
+}
+
+WorkerScope::WorkerScope() : m_Nested(t_InScope) {
+    if (m_Nested) return;
+    t_InScope = true;
+    s_Busy.fetch_add(1);
+}
+
+WorkerScope::~WorkerScope() {
+    if (m_Nested) return;
+    s_Busy.fetch_sub(1);
+    t_InScope = false;
+}
+
+WorkerLease::WorkerLease(size_t wanted, LeaseMode mode) {
+    // The calling thread works along; outside a scope it is not counted as busy yet
+    const size_t self = t_InScope ? 0 : 1;
+    const size_t budget = WorkerCount();
+    size_t busy = s_Busy.load();
+    for (;;) {
+        const size_t idle = budget > busy + self ? budget - busy - self : 0;
+        const size_t grant = std::min(wanted, idle);
+        if (grant == 0 || (mode == LeaseMode::AllOrNothing && grant < wanted)) return;
+        if (s_Busy.compare_exchange_weak(busy, busy + grant)) {
+            m_Count = grant;
+            return;
+        }
+    }
+}
+
+WorkerLease::~WorkerLease() {
+    if (m_Count) s_Busy.fetch_sub(m_Count);
+}
+
+}  // namespace ccad
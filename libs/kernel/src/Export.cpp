@@ -1,6 +1,4 @@
-#include <BRepMesh_IncrementalMesh.hxx>
 #include <STEPControl_Writer.hxx>
-#include <StlAPI_Writer.hxx>
 #include <TopoDS_Shape.hxx>
 #include <ccad/base/Logger.hpp>
 #include <ccad/io/Export.hpp>
@@ -9,18 +7,13 @@
 
 namespace ccad::io {
 
-bool SaveSTL(const Shape& shape, const std::string& path, geom::TriangulationParams p) {
+bool SaveSTL(const Shape& shape, const std::string& path, geom::TriangulationParams p, const StlOptions& opt) {
     auto s = ShapeAsOcct(shape);
     if (!s) throw std::runtime_error("SaveSTL: non-OCCT shape implementation");
 
-    auto os = s->Occt();
-
-    // TODO: maybe check if already triangulated, and use the cached one!
-
-    BRepMesh_IncrementalMesh mesher(os, p.linearDeflection, false, DegToRad(p.angularDeflectionDeg), p.parallel);
-    mesher.Perform();
-    StlAPI_Writer writer;
-    if (writer.Write(os, path.c_str())) {
+    // Reuse the session mesh cache: the viewer or a previous export may already have meshed this shape.
+    auto mesh = geom::TriangulateShared(shape, p);
+    if (WriteSTL(*mesh, path, opt)) {
         LOG(INFO) << "Wrote STL: " << path << "\n";
         return true;
     }
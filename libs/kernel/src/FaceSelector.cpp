@@ -0,0 +1,349 @@
+/**
+ * @file FaceSelector.cpp
+ * @brief OCCT-backed implementation of ccad::select::FaceSelector.
+ */
+
+#include "ccad/select/FaceSelector.hpp"
+
+#include <algorithm>
+#include <ccad/base/Logger.hpp>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+// -------- internal OCCT bridge headers  --------
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepGProp.hxx>
+#include <BRepLProp_SLProps.hxx>
+#include <Bnd_Box.hxx>
+#include <GProp_GProps.hxx>
+#include <GeomAbs_SurfaceType.hxx>
+#include <IntCurvesFace_Intersector.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Lin.hxx>
+#include <gp_Pnt.hxx>
+
+#include "internal/ThreadPool.hpp"
+#include "internal/geom/ShapeHelper.hpp"
+#include "internal/select/Columns.hpp"
+#include "internal/select/FaceTable.hpp"
+
+namespace ccad::select {
+
+// ---------- FaceTable columns ----------
+static constexpr size_t kGrain = 16;
+
+static FaceGeom ToFaceGeom(GeomAbs_SurfaceType t) {
+    switch (t) {
+        case GeomAbs_Plane:
+            return FaceGeom::Plane;
+        case GeomAbs_Cylinder:
+            return FaceGeom::Cylinder;
+        case GeomAbs_Cone:
+            return FaceGeom::Cone;
+        case GeomAbs_Sphere:
+            return FaceGeom::Sphere;
+        case GeomAbs_Torus:
+            return FaceGeom::Torus;
+        default:
+            return FaceGeom::Other;
+    }
+}
+
+void FaceTable::computeSurface() {
+    const size_t n = size();
+    geom.assign(n, static_cast<uint8_t>(FaceGeom::Other));
+    nx.assign(n, 0.0);
+    ny.assign(n, 0.0);
+    nz.assign(n, 1.0);
+    ParallelFor(0, n, kGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const TopoDS_Face& F = face(i);
+            BRepAdaptor_Surface s(F);
+            geom[i] = static_cast<uint8_t>(ToFaceGeom(s.GetType()));
+
+            const Standard_Real u = 0.5 * (s.FirstUParameter() + s.LastUParameter());
+            const Standard_Real v = 0.5 * (s.FirstVParameter() + s.LastVParameter());
+            try {
+                BRepLProp_SLProps props(s, u, v, /*DerivativeOrder*/ 1, tol);
+                if (!props.IsNormalDefined()) continue;
+                gp_Dir N = props.Normal();
+                if (F.Orientation() == TopAbs_REVERSED) N.Reverse();  // outward for solids
+                nx[i] = N.X();
+                ny[i] = N.Y();
+                nz[i] = N.Z();
+            } catch (...) {
+                LOG(ERROR) << "[faces] normal undefined for face " << i;
+            }
+        }
+    });
+}
+
+void FaceTable::computeMass() {
+    const size_t n = size();
+    area.assign(n, 0.0);
+    cx.assign(n, 0.0);
+    cy.assign(n, 0.0);
+    cz.assign(n, 0.0);
+    ParallelFor(0, n, kGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            GProp_GProps props;
+            BRepGProp::SurfaceProperties(face(i), props);
+            const gp_Pnt c = props.CentreOfMass();
+            area[i] = props.Mass();
+            cx[i] = c.X();
+            cy[i] = c.Y();
+            cz[i] = c.Z();
+        }
+    });
+}
+
+void FaceTable::computeAdjacency() {
+    const size_t n = size();
+    TopTools_IndexedDataMapOfShapeListOfShape edge2faces;
+    TopExp::MapShapesAndAncestors(shape, TopAbs_EDGE, TopAbs_FACE, edge2faces);
+
+    std::vector<std::vector<size_t>> lists(n);
+    for (int e = 1; e <= edge2faces.Extent(); ++e) {
+        std::vector<size_t> around;
+        for (TopTools_ListIteratorOfListOfShape it(edge2faces.FindFromIndex(e)); it.More(); it.Next()) {
+            const int idx = faceMap.FindIndex(it.Value());
+            if (idx > 0) around.push_back(static_cast<size_t>(idx - 1));
+        }
+        for (size_t a : around)
+            for (size_t b : around)
+                if (a != b) lists[a].push_back(b);
+    }
+
+    adjOffsets.assign(n + 1, 0);
+    adj.clear();
+    for (size_t i = 0; i < n; ++i) {
+        auto& l = lists[i];
+        std::sort(l.begin(), l.end());
+        l.erase(std::unique(l.begin(), l.end()), l.end());
+        adj.insert(adj.end(), l.begin(), l.end());
+        adjOffsets[i + 1] = adj.size();
+    }
+}
+
+void FaceTable::computeBounds() {
+    Bnd_Box bb;
+    BRepBndLib::Add(shape, bb, false);
+    bb.Get(bboxMin[0], bboxMin[1], bboxMin[2], bboxMax[0], bboxMax[1], bboxMax[2]);
+    // Get() widens the box by the shape tolerance (the gap); box sides are matched against the geometry
+    const double gap = bb.GetGap();
+    for (int k = 0; k < 3; ++k) {
+        bboxMin[k] += gap;
+        bboxMax[k] -= gap;
+    }
+}
+
+void FaceTable::computeBoxes() {
+    const size_t n = size();
+    boxes.assign(n, Bounds{{1, 1, 1}, {0, 0, 0}});  // invalid until computed
+    ParallelFor(0, n, kGrain, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Bnd_Box bb;
+            BRepBndLib::Add(face(i), bb, false);
+            if (bb.IsVoid()) continue;
+            double x0, y0, z0, x1, y1, z1;
+            bb.Get(x0, y0, z0, x1, y1, z1);
+            boxes[i] = Bounds{{x0, y0, z0}, {x1, y1, z1}};
+        }
+    });
+    bvh = Bvh(boxes);
+}
+
+// ---------- FaceSet ops ----------
+std::vector<FaceRef> FaceSet::items() const {
+    std::vector<FaceRef> out;
+    if (!m_table) return out;
+    for (auto a : {FaceTable::kSurface, FaceTable::kMass, FaceTable::kAdjacency}) m_table->ensure(a);
+    out.reserve(m_bits.count());
+    m_bits.forEach([&](size_t i) { out.push_back(m_table->ref(i)); });
+    return out;
+}
+
+FaceSet& FaceSet::unite(const FaceSet& b) {
+    if (!b.m_table) return *this;
+    AlignSets(m_table, m_bits, b.m_table, b.m_bits, "FaceSet");
+    m_bits |= b.m_bits;
+    return *this;
+}
+
+FaceSet& FaceSet::intersect(const FaceSet& b) {
+    if (!b.m_table) {
+        m_bits = BitSet(m_bits.size());
+        return *this;
+    }
+    AlignSets(m_table, m_bits, b.m_table, b.m_bits, "FaceSet");
+    m_bits &= b.m_bits;
+    return *this;
+}
+
+FaceSet& FaceSet::subtract(const FaceSet& b) {
+    if (!b.m_table || !m_table) return *this;
+    AlignSets(m_table, m_bits, b.m_table, b.m_bits, "FaceSet");
+    m_bits.andNot(b.m_bits);
+    return *this;
+}
+
+// ---------- FaceSelector API ----------
+FaceSelector FaceSelector::FromShape(const ccad::Shape& s, double tolerance) {
+    auto occ = ShapeAsOcct(s);
+    if (!occ) throw std::runtime_error("FaceSelector: non-OCCT shape implementation");
+    return FaceSelector(std::make_shared<FaceTable>(occ->Occt(), tolerance));
+}
+
+FaceSelector& FaceSelector::geom(FaceGeom g) {
+    m_filters.geom = g;
+    return *this;
+}
+
+FaceSelector& FaceSelector::normalParallelTo(Axis axis, double tolDeg) {
+    m_filters.normalAxisTolDeg = std::make_pair(axis, tolDeg);
+    return *this;
+}
+
+FaceSelector& FaceSelector::onBoxSide(BoxSide side, double tol) {
+    m_filters.boxSideTol = std::make_pair(side, tol);
+    return *this;
+}
+
+FaceSelector& FaceSelector::areaBetween(const AreaRange& r) {
+    m_filters.area = r;
+    return *this;
+}
+
+FaceSelector& FaceSelector::adjacentTo(const FaceSet& seeds) {
+    if (seeds.bits().size() != m_table->size()) {
+        throw std::runtime_error("FaceSelector::adjacentTo: seeds belong to a different shape");
+    }
+    m_filters.adjacentTo = seeds.bits();
+    return *this;
+}
+
+FaceSelector& FaceSelector::nearPoint(const glm::vec3& p, double radius) {
+    m_filters.nearPoint = std::make_pair(p, radius);
+    return *this;
+}
+
+FaceSelector& FaceSelector::hitByRay(const glm::vec3& origin, const glm::vec3& dir, bool firstOnly) {
+    const double len = std::sqrt(double(dir.x) * dir.x + double(dir.y) * dir.y + double(dir.z) * dir.z);
+    if (!(len > 0.0)) throw std::invalid_argument("FaceSelector::hitByRay: direction must not be zero");
+    // Unit direction: the BVH box entry and the face hit parameter are then both plain distances
+    const glm::vec3 unit(dir.x / len, dir.y / len, dir.z / len);
+    m_filters.ray = std::make_tuple(origin, unit, firstOnly);
+    return *this;
+}
+
+FaceSelector& FaceSelector::largest(size_t n) {
+    m_filters.largest = n;
+    return *this;
+}
+
+FaceSet FaceSelector::collect() const {
+    // Build only the attribute groups the active filters read
+    FaceTable& t = *m_table;
+    const bool needSurface = (m_filters.geom && *m_filters.geom != FaceGeom::Any) || m_filters.normalAxisTolDeg;
+    const bool needMass = m_filters.area || m_filters.boxSideTol || m_filters.largest;
+    if (needSurface) t.ensure(FaceTable::kSurface);
+    if (needMass) t.ensure(FaceTable::kMass);
+    if (m_filters.adjacentTo) t.ensure(FaceTable::kAdjacency);
+    if (m_filters.boxSideTol) t.ensure(FaceTable::kBounds);
+    if (m_filters.nearPoint || m_filters.ray) t.ensure(FaceTable::kBoxes);
+
+    const size_t n = t.size();
+    std::vector<uint8_t> keep(n, 1);
+    uint8_t* k = keep.data();
+
+    // spatial filters: BVH candidates, then the exact test on those only
+    if (m_filters.nearPoint) {
+        const auto& [p, radius] = *m_filters.nearPoint;
+        std::vector<size_t> hits;
+        const TopoDS_Vertex V = BRepBuilderAPI_MakeVertex(gp_Pnt(p.x, p.y, p.z));
+        for (size_t i : t.bvh.Near(Vec3(p.x, p.y, p.z), radius)) {
+            BRepExtrema_DistShapeShape dist(V, t.face(i));
+            if (dist.IsDone() && dist.Value() <= radius) hits.push_back(i);
+        }
+        KeepOnly(k, n, hits);
+    }
+    if (m_filters.ray) {
+        const auto& [o, d, firstOnly] = *m_filters.ray;
+        const gp_Lin line(gp_Pnt(o.x, o.y, o.z), gp_Dir(d.x, d.y, d.z));
+        std::vector<size_t> hits;
+        double nearest = std::numeric_limits<double>::infinity();
+        // candidates come sorted by box entry; once a box starts beyond the nearest hit, stop
+        for (const auto& [i, tBox] : t.bvh.Ray(Vec3(o.x, o.y, o.z), Vec3(d.x, d.y, d.z))) {
+            if (firstOnly && tBox > nearest) break;
+            IntCurvesFace_Intersector inter(t.face(i), t.tol);
+            inter.Perform(line, 0.0, RealLast());
+            if (!inter.IsDone() || inter.NbPnt() == 0) continue;
+            double w = inter.WParameter(1);
+            for (int j = 2; j <= inter.NbPnt(); ++j) w = std::min(w, inter.WParameter(j));
+            if (!firstOnly) {
+                hits.push_back(i);
+            } else if (w < nearest) {
+                nearest = w;
+                hits.assign(1, i);
+            }
+        }
+        KeepOnly(k, n, hits);
+    }
+
+    if (m_filters.geom && *m_filters.geom != FaceGeom::Any) {
+        KeepEqual(k, t.geom.data(), n, static_cast<uint8_t>(*m_filters.geom));
+    }
+    // normals are unit vectors, so |dot(n, axis)| is the axis component
+    if (m_filters.normalAxisTolDeg) {
+        const auto [ax, tolDeg] = *m_filters.normalAxisTolDeg;
+        KeepAbsAtLeast(k, t.normalColumn(ax).data(), n, std::cos(DegToRad(tolDeg)));
+    }
+    if (m_filters.boxSideTol) {
+        const auto [side, tol] = *m_filters.boxSideTol;
+        const Axis ax = (side == BoxSide::XMin || side == BoxSide::XMax)   ? Axis::X
+                        : (side == BoxSide::YMin || side == BoxSide::YMax) ? Axis::Y
+                                                                           : Axis::Z;
+        const bool isMin = side == BoxSide::XMin || side == BoxSide::YMin || side == BoxSide::ZMin;
+        const int c = static_cast<int>(ax);
+        KeepNear(k, t.centroidColumn(ax).data(), n, isMin ? t.bboxMin[c] : t.bboxMax[c], tol);
+    }
+    if (m_filters.area) {
+        KeepRange(k, t.area.data(), n, m_filters.area->min, m_filters.area->max);
+    }
+    if (m_filters.adjacentTo) {
+        const BitSet& seeds = *m_filters.adjacentTo;
+        std::vector<uint8_t> near(n, 0);
+        seeds.forEach([&](size_t s) {
+            for (size_t j = t.adjOffsets[s]; j < t.adjOffsets[s + 1]; ++j) near[t.adj[j]] = 1;
+        });
+        seeds.forEach([&](size_t s) { near[s] = 0; });
+        for (size_t i = 0; i < n; ++i) k[i] &= near[i];
+    }
+
+    FaceSet out;
+    out.m_table = m_table;
+    out.m_bits = BitSet(n);
+    out.m_bits.assignMask(k);
+
+    if (m_filters.largest && out.m_bits.count() > *m_filters.largest) {
+        std::vector<size_t> idx = out.m_bits.indices();
+        const size_t keepN = *m_filters.largest;
+        std::partial_sort(idx.begin(), idx.begin() + keepN, idx.end(),
+                          [&](size_t a, size_t b) { return t.area[a] > t.area[b]; });
+        out.m_bits = BitSet(n);
+        for (size_t i = 0; i < keepN; ++i) out.m_bits.set(idx[i]);
+    }
+    return out;
+}
+
+}  // namespace ccad::select
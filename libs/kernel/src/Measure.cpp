@@ -0,0 +1,31 @@
+#include "ccad/base/Measure.hpp"
+
+#include <stdexcept>
+
+#include "internal/geom/ShapeHelper.hpp"
+
+namespace ccad {
+
+namespace {
+
+const OcctShape& Occt(const Shape& s, const char* what) {
+    auto os = ShapeAsOcct(s);
+    if (!os) throw std::runtime_error(std::string(what) + ": non-OCCT shape implementation");
+    return *os;
+}
+
+}  // namespace
+
+MassProps MassProperties(const Shape& s) {
+    return Occt(s, "MassProperties").Mass();
+}
+
+TopoCounts CountTopology(const Shape& s) {
+    return Occt(s, "CountTopology").Counts();
+}
+
+bool IsValidShape(const Shape& s) {
+    return Occt(s, "IsValidShape").IsValid();
+}
+
+}  // namespace ccad
@@ -0,0 +1,125 @@
+#include "internal/geom/MeshCache.hpp"
+
+#include <algorithm>
+
+#include "ccad/base/Exception.hpp"
+#include "ccad/base/Progress.hpp"
+#include "internal/Stats.hpp"
+
+namespace ccad::geom {
+
+static size_t MeshBytes(const TriMesh& m) {
+    return m.positions.size() * sizeof(Vec3) + m.normals.size() * sizeof(Vec3) + m.indices.size() * sizeof(unsigned);
+}
+
+MeshCache& MeshCache::Instance() {
+    static MeshCache cache;
+    return cache;
+}
+
+MeshCache::MeshPtr MeshCache::GetOrCreate(const TopoDS_Shape& shape, const TriangulationParams& p,
+                                          const Builder& build) {
+    const Key key = shape.TShape().get();
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    auto& bucket = m_Entries[key];
+    for (const auto& e : bucket) {
+        if (e->Matches(shape, p)) {
+            e->lastUse = ++m_Tick;
+            Counters().meshCacheHits++;
+            auto pending = e->mesh;
+            lock.unlock();
+            try {
+                return pending.get();  // waits if another thread is still meshing this key
+            } catch (const Exception& ex) {
+                // That thread was cancelled, this one was not: its entry is gone, mesh here instead
+                if (ex.getStatus() != Status::CANCELLED || IsCancelled()) throw;
+            }
+            return GetOrCreate(shape, p, build);
+        }
+    }
+
+    Counters().meshCacheMisses++;
+    auto entry = std::make_shared<Entry>();
+    entry->shape = shape;
+    entry->linearDeflection = p.linearDeflection;
+    entry->angularDeflectionDeg = p.angularDeflectionDeg;
+    entry->curvatureAware = p.curvatureAware;
+    entry->weld = p.weld;
+    entry->creaseAngleDeg = p.creaseAngleDeg;
+    entry->lastUse = ++m_Tick;
+
+    std::promise<MeshPtr> promise;
+    entry->mesh = promise.get_future().share();
+    bucket.push_back(entry);
+    lock.unlock();
+
+    MeshPtr mesh;
+    try {
+        mesh = std::make_shared<const TriMesh>(build());
+    } catch (...) {
+        lock.lock();
+        Remove(key, entry);  // before waiters wake up, so they do not find the failed entry again
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    promise.set_value(mesh);
+
+    lock.lock();
+    entry->bytes = std::max<size_t>(1, MeshBytes(*mesh));
+    m_Bytes += entry->bytes;
+    EvictLocked(entry);
+    return mesh;
+}
+
+void MeshCache::Remove(Key key, const EntryPtr& e) {
+    auto it = m_Entries.find(key);
+    if (it == m_Entries.end()) return;
+    auto& bucket = it->second;
+    bucket.erase(std::remove(bucket.begin(), bucket.end(), e), bucket.end());
+    if (bucket.empty()) m_Entries.erase(it);
+}
+
+void MeshCache::EvictLocked(const EntryPtr& keep) {
+    while (m_Bytes > m_Budget) {
+        Key victimKey = nullptr;
+        EntryPtr victim;
+        for (const auto& kv : m_Entries) {
+            for (const auto& e : kv.second) {
+                if (e == keep || e->bytes == 0) continue;
+                if (!victim || e->lastUse < victim->lastUse) {
+                    victim = e;
+                    victimKey = kv.first;
+                }
+            }
+        }
+        if (!victim) break;
+        m_Bytes -= victim->bytes;
+        Remove(victimKey, victim);
+    }
+}
+
+void MeshCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    // Entries which are still being built stay; their builders account for them on completion.
+    for (auto it = m_Entries.begin(); it != m_Entries.end();) {
+        auto& bucket = it->second;
+        bucket.erase(std::remove_if(bucket.begin(), bucket.end(),
+                                    [this](const EntryPtr& e) {
+                                        if (e->bytes == 0) return false;
+                                        m_Bytes -= e->bytes;
+                                        return true;
+                                    }),
+                     bucket.end());
+        it = bucket.empty() ? m_Entries.erase(it) : std::next(it);
+    }
+}
+
+void MeshCache::SetBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Budget = bytes;
+    EvictLocked(nullptr);
+}
+
+}  // namespace ccad::geom
@@ -1,20 +1,106 @@
 #include "internal/geom/OcctShape.hpp"
 
 #include <BRepBndLib.hxx>
+#include <BRepCheck_Analyzer.hxx>
 #include <BRepGProp.hxx>
 #include <Bnd_Box.hxx>
 #include <GProp_GProps.hxx>
 #include <Standard_TypeDef.hxx>
+#include <TopExp.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 
 #include "ccad/base/Math.hpp"
+#include "internal/Stats.hpp"
 
 using namespace ccad;
 
+namespace {
+
+int CountOf(const TopoDS_Shape& s, TopAbs_ShapeEnum kind) {
+    TopTools_IndexedMapOfShape map;
+    TopExp::MapShapes(s, kind, map);
+    return map.Extent();
+}
+
+}  // namespace
+
 Bounds ccad::OcctShape::BoundingBox() const {
-    Bnd_Box bb;
-    BRepBndLib::Add(m_Shape, bb);
+    const Bnd_Box& bb = AxisBox();
+    if (bb.IsVoid()) return Bounds{{1, 1, 1}, {0, 0, 0}};
     Standard_Real xmin, ymin, zmin, xmax, ymax, zmax;
     bb.Get(xmin, ymin, zmin, xmax, ymax, zmax);
 
     return Bounds{{xmin, ymin, zmin}, {xmax, ymax, zmax}};
 }
+
+const Bnd_Box& ccad::OcctShape::AxisBox() const {
+    Cache& c = *m_Cache;
+    std::call_once(c.boxOnce, [&]() { BRepBndLib::Add(m_Shape, c.box); });
+    return c.box;
+}
+
+const Bnd_OBB& ccad::OcctShape::OrientedBox() const {
+    Cache& c = *m_Cache;
+    std::call_once(c.obbOnce, [&]() {
+        // From the exact geometry, enlarged by the tolerances: the boolean prefilter needs a conservative box,
+        // one fitted to a triangulation may cut through curved faces
+        if (AxisBox().IsVoid()) return;
+        BRepBndLib::AddOBB(m_Shape, c.obb, /*triangulation*/ Standard_False, /*optimal*/ Standard_True,
+                           /*tolerance*/ Standard_True);
+    });
+    return c.obb;
+}
+
+bool ccad::OcctShape::IsValid() const {
+    Cache& c = *m_Cache;
+    std::call_once(c.validOnce, [&]() {
+        Counters().validityChecks.fetch_add(1, std::memory_order_relaxed);
+        c.valid = !m_Shape.IsNull() && BRepCheck_Analyzer(m_Shape).IsValid();
+        c.validKnown.store(true, std::memory_order_release);
+    });
+    return c.valid;
+}
+
+void ccad::OcctShape::MarkValid() const {
+    Cache& c = *m_Cache;
+    std::call_once(c.validOnce, [&]() {
+        c.valid = true;
+        c.validKnown.store(true, std::memory_order_release);
+    });
+}
+
+bool ccad::OcctShape::ValidityKnown() const {
+    return m_Cache->validKnown.load(std::memory_order_acquire);
+}
+
+const MassProps& ccad::OcctShape::Mass() const {
+    Cache& c = *m_Cache;
+    std::call_once(c.massOnce, [&]() {
+        if (m_Shape.IsNull()) return;
+        GProp_GProps surface;
+        BRepGProp::SurfaceProperties(m_Shape, surface);
+        c.mass.area = surface.Mass();
+
+        GProp_GProps volume;
+        BRepGProp::VolumeProperties(m_Shape, volume);
+        c.mass.volume = volume.Mass();
+
+        const GProp_GProps& ref = c.mass.volume > 0.0 ? volume : surface;
+        const gp_Pnt g = ref.Mass() > 0.0 ? ref.CentreOfMass() : gp_Pnt(0, 0, 0);
+        c.mass.centroid = Vec3{g.X(), g.Y(), g.Z()};
+    });
+    return c.mass;
+}
+
+const TopoCounts& ccad::OcctShape::Counts() const {
+    Cache& c = *m_Cache;
+    std::call_once(c.countsOnce, [&]() {
+        if (m_Shape.IsNull()) return;
+        c.counts.solids = CountOf(m_Shape, TopAbs_SOLID);
+        c.counts.shells = CountOf(m_Shape, TopAbs_SHELL);
+        c.counts.faces = CountOf(m_Shape, TopAbs_FACE);
+        c.counts.edges = CountOf(m_Shape, TopAbs_EDGE);
+        c.counts.vertices = CountOf(m_Shape, TopAbs_VERTEX);
+    });
+    return c.counts;
+}
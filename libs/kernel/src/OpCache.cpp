@@ -0,0 +1,97 @@
+#include "internal/OpCache.hpp"
+
+#include "ccad/base/OpCache.hpp"
+#include "internal/Stats.hpp"
+
+namespace ccad {
+
+namespace {
+
+/// Rough in-memory size of a B-Rep, from its topology counts.
+size_t EstimateBytes(const Shape& s) {
+    auto os = ShapeAsOcct(s);
+    if (!os) return 1024;
+    const auto& n = os->Counts();
+    return 1024 + size_t(n.faces) * 2048 + size_t(n.edges) * 512 + size_t(n.vertices) * 128;
+}
+
+}  // namespace
+
+OpCache& OpCache::Instance() {
+    static OpCache cache;
+    return cache;
+}
+
+bool OpCache::Enabled() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Budget > 0;
+}
+
+bool OpCache::Lookup(uint64_t key, Shape& out) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Index.find(key);
+    if (it == m_Index.end()) {
+        Counters().opCacheMisses.fetch_add(1, std::memory_order_relaxed);
+        ++ThreadCounters().misses;
+        return false;
+    }
+    m_Lru.splice(m_Lru.begin(), m_Lru, it->second);
+    out = it->second->shape;
+    Counters().opCacheHits.fetch_add(1, std::memory_order_relaxed);
+    Counters().opCacheSavedNs.fetch_add(it->second->buildNs, std::memory_order_relaxed);
+    ++ThreadCounters().hits;
+    ThreadCounters().savedNs += it->second->buildNs;
+    return true;
+}
+
+void OpCache::Store(uint64_t key, const Shape& s, uint64_t buildNs) {
+    auto os = ShapeAsOcct(s);
+    if (!os) return;
+    os->SetKey(key);
+    if (os->Key() != key) return;  // an input passed through (fast path or fallback): cheap to redo
+    const size_t bytes = EstimateBytes(s);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_Index.count(key)) return;  // computed concurrently by another caller
+    m_Lru.push_front(Entry{key, s, bytes, buildNs});
+    m_Index[key] = m_Lru.begin();
+    m_Bytes += bytes;
+    EvictLocked();
+}
+
+void OpCache::EvictLocked() {
+    while (m_Bytes > m_Budget && !m_Lru.empty()) {
+        const Entry& victim = m_Lru.back();
+        m_Bytes -= victim.bytes;
+        m_Index.erase(victim.key);
+        m_Lru.pop_back();
+    }
+}
+
+void OpCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Lru.clear();
+    m_Index.clear();
+    m_Bytes = 0;
+}
+
+void OpCache::SetBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Budget = bytes;
+    EvictLocked();
+}
+
+size_t OpCache::Size() const {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Lru.size();
+}
+
+void ClearOpCache() {
+    OpCache::Instance().Clear();
+}
+
+void SetOpCacheBudget(size_t bytes) {
+    OpCache::Instance().SetBudget(bytes);
+}
+
+}  // namespace ccad
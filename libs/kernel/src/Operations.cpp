@@ -1,62 +1,434 @@
 #include <BRepAlgoAPI_Common.hxx>
 #include <BRepAlgoAPI_Cut.hxx>
 #include <BRepAlgoAPI_Fuse.hxx>
+#include <BRepBndLib.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
+#include <BRep_Builder.hxx>
+#include <Bnd_Box.hxx>
+#include <Bnd_OBB.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopoDS_Compound.hxx>
+#include <algorithm>
+#include <atomic>
+#include <ccad/base/Logger.hpp>
+#include <cmath>
+#include <cstdint>
 #include <gp_Ax1.hxx>
 #include <gp_Dir.hxx>
 #include <gp_Pnt.hxx>
+#include <gp.hxx>
 #include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
 
 #include "ccad/ops/Boolean.hpp"
 #include "ccad/ops/Transform.hpp"
+#include "internal/Execution.hpp"
+#include "internal/OpCache.hpp"
+#include "internal/Progress.hpp"
+#include "internal/Stats.hpp"
 #include "internal/geom/ShapeHelper.hpp"
 
 namespace ccad {
 namespace ops {
 
+// --- Bounding-box prefilter ------------------------------------------------
+
+namespace {
+
+std::atomic<BooleanPrefilter> g_Prefilter{BooleanPrefilter::AABB};
+
+/// Conservative bounds of one operand, read from the shape's cache; the OBB is only used in OBB mode.
+struct Bounds {
+    Bnd_Box box;
+    Bnd_OBB obb;
+};
+
+Bounds BoundsOf(const OcctShape& s, BooleanPrefilter mode) {
+    Bounds b;
+    b.box = s.AxisBox();
+    if (mode == BooleanPrefilter::OBB) b.obb = s.OrientedBox();
+    return b;
+}
+
+/// True if the operands provably do not touch. Touching operands must still go through OCCT to share faces.
+bool Disjoint(const Bounds& a, const Bounds& b, BooleanPrefilter mode) {
+    if (a.box.IsOut(b.box)) return true;
+    if (mode == BooleanPrefilter::OBB && !a.obb.IsVoid() && !b.obb.IsVoid()) return a.obb.IsOut(b.obb);
+    return false;
+}
+
+TopoDS_Shape MakeCompound(const std::vector<TopoDS_Shape>& shapes) {
+    TopoDS_Compound comp;
+    BRep_Builder builder;
+    builder.MakeCompound(comp);
+    for (const auto& s : shapes) builder.Add(comp, s);
+    return comp;
+}
+
+/// Single-shape argument list. The two-shape BRepAlgoAPI constructors already run the operation,
+/// so pairwise booleans set their arguments this way and build once, in parallel and with progress.
+TopTools_ListOfShape ListOf(const TopoDS_Shape& s) {
+    TopTools_ListOfShape list;
+    list.Append(s);
+    return list;
+}
+
+void CountFastPath() { Counters().booleanFastPaths.fetch_add(1, std::memory_order_relaxed); }
+
+/// Group operands whose bounds overlap (transitively); each group has to be fused, groups never touch each other.
+std::vector<std::vector<size_t>> OverlapGroups(const std::vector<Bounds>& bounds, BooleanPrefilter mode) {
+    const size_t n = bounds.size();
+
+    std::vector<size_t> parent(n);
+    for (size_t i = 0; i < n; ++i) parent[i] = i;
+    auto find = [&](size_t i) {
+        while (parent[i] != i) i = parent[i] = parent[parent[i]];
+        return i;
+    };
+
+    // Sweep along X: only operands whose X intervals overlap need the full test
+    auto xmin = [&](size_t i) { return bounds[i].box.IsVoid() ? 0.0 : bounds[i].box.CornerMin().X(); };
+    auto xmax = [&](size_t i) { return bounds[i].box.IsVoid() ? 0.0 : bounds[i].box.CornerMax().X(); };
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return xmin(a) < xmin(b); });
+
+    for (size_t oi = 0; oi < n; ++oi) {
+        const size_t i = order[oi];
+        if (bounds[i].box.IsVoid()) continue;
+        for (size_t oj = oi + 1; oj < n && xmin(order[oj]) <= xmax(i); ++oj) {
+            const size_t j = order[oj];
+            if (find(i) == find(j) || Disjoint(bounds[i], bounds[j], mode)) continue;
+            parent[find(i)] = find(j);
+        }
+    }
+
+    std::vector<std::vector<size_t>> groups;
+    std::vector<size_t> slot(n, SIZE_MAX);
+    for (size_t i = 0; i < n; ++i) {
+        size_t r = find(i);
+        if (slot[r] == SIZE_MAX) {
+            slot[r] = groups.size();
+            groups.emplace_back();
+        }
+        groups[slot[r]].push_back(i);
+    }
+    return groups;
+}
+
+}  // namespace
+
+void SetBooleanPrefilter(BooleanPrefilter mode) { g_Prefilter = mode; }
+
+BooleanPrefilter GetBooleanPrefilter() { return g_Prefilter; }
+
+// --- Union -----------------------------------------------------------------
+
+namespace {
+
+/// Fuse `objects` with `tools` in a single General Fuse pass; returns false if OCCT reports failure.
+bool FuseOnce(const TopTools_ListOfShape& objects, const TopTools_ListOfShape& tools, TopoDS_Shape& out) {
+    BRepAlgoAPI_Fuse algo;
+    algo.SetArguments(objects);
+    algo.SetTools(tools);
+    algo.SetNonDestructive(Standard_True);  // inputs may be shared through the operation cache
+    WorkerLease lease(WorkerCount() - 1, LeaseMode::AllOrNothing);  // OCCT's pool runs at full width
+    algo.SetRunParallel(lease.Count() > 0);
+    OperationProgress progress("Union");
+    algo.Build(progress.Range());
+    progress.ThrowIfCancelled();
+    if (!algo.IsDone() || algo.HasErrors()) return false;
+    out = algo.Shape();
+    return true;
+}
+
+TopoDS_Shape FusePair(const TopoDS_Shape& a, const TopoDS_Shape& b) {
+    TopTools_ListOfShape objects, tools;
+    objects.Append(a);
+    tools.Append(b);
+    TopoDS_Shape out;
+    if (!FuseOnce(objects, tools, out)) throw std::runtime_error("Union failed");
+    return out;
+}
+
+/// Spread the lower 10 bits of v so that two zero bits separate each of them (Morton encoding).
+uint32_t SpreadBits(uint32_t v) {
+    v &= 0x3ff;
+    v = (v | (v << 16)) & 0x030000ff;
+    v = (v | (v << 8)) & 0x0300f00f;
+    v = (v | (v << 4)) & 0x030c30c3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+/// Order shapes along a Z-order curve over their bounding box centers, so that neighbours are spatially close.
+void SortSpatially(std::vector<TopoDS_Shape>& shapes) {
+    std::vector<gp_Pnt> centers;
+    centers.reserve(shapes.size());
+    Bnd_Box all;
+    for (const auto& s : shapes) {
+        Bnd_Box b;
+        BRepBndLib::Add(s, b);
+        gp_Pnt c(0, 0, 0);
+        if (!b.IsVoid()) {
+            c = gp_Pnt((b.CornerMin().XYZ() + b.CornerMax().XYZ()) * 0.5);
+            all.Add(c);
+        }
+        centers.push_back(c);
+    }
+    if (all.IsVoid()) return;
+
+    const gp_Pnt lo = all.CornerMin(), hi = all.CornerMax();
+    auto quantize = [](double v, double a, double b) {
+        return b > a ? static_cast<uint32_t>((v - a) / (b - a) * 1023.0) : 0u;
+    };
+
+    std::vector<std::pair<uint32_t, size_t>> keys(shapes.size());
+    for (size_t i = 0; i < shapes.size(); ++i) {
+        const auto& c = centers[i];
+        keys[i] = {SpreadBits(quantize(c.X(), lo.X(), hi.X())) | (SpreadBits(quantize(c.Y(), lo.Y(), hi.Y())) << 1) |
+                       (SpreadBits(quantize(c.Z(), lo.Z(), hi.Z())) << 2),
+                   i};
+    }
+    std::stable_sort(keys.begin(), keys.end());
+
+    std::vector<TopoDS_Shape> sorted;
+    sorted.reserve(shapes.size());
+    for (const auto& k : keys) sorted.push_back(shapes[k.second]);
+    shapes.swap(sorted);
+}
+
+/// Balanced pairwise reduction; neighbours are fused first, so intermediate results stay small.
+TopoDS_Shape FuseTree(std::vector<TopoDS_Shape> level) {
+    SortSpatially(level);
+    while (level.size() > 1) {
+        std::vector<TopoDS_Shape> next;
+        next.reserve((level.size() + 1) / 2);
+        for (size_t i = 0; i + 1 < level.size(); i += 2) next.push_back(FusePair(level[i], level[i + 1]));
+        if (level.size() % 2) next.push_back(level.back());
+        level.swap(next);
+    }
+    return level.front();
+}
+
+/// One General Fuse over all shapes, with the tree reduction as fallback.
+TopoDS_Shape FuseAll(std::vector<TopoDS_Shape> shapes) {
+    if (shapes.size() == 1) return shapes.front();
+
+    // All operands in one General Fuse: every pair is intersected exactly once
+    TopTools_ListOfShape objects, tools;
+    objects.Append(shapes.front());
+    for (size_t i = 1; i < shapes.size(); ++i) tools.Append(shapes[i]);
+
+    TopoDS_Shape fused;
+    if (FuseOnce(objects, tools, fused)) return fused;
+
+    LOG(WARN) << "Union: single-pass fuse of " << shapes.size() << " shapes failed, falling back to tree reduction\n";
+    return FuseTree(std::move(shapes));
+}
+
+}  // namespace
+
 Shape Union(const std::vector<Shape>& shapes) {
     if (shapes.size() < 2) throw std::runtime_error("Union: More than two shapes are required");
 
-    auto shape = ShapeAsOcct(shapes[0])->Occt();
+    return Memoize(OpKey("Union").Inputs(shapes).Param(GetBooleanPrefilter()), [&]() {
+        std::vector<const OcctShape*> operands;
+        std::vector<TopoDS_Shape> occt;
+        operands.reserve(shapes.size());
+        occt.reserve(shapes.size());
+        for (const auto& s : shapes) {
+            auto os = ShapeAsOcct(s);
+            if (!os) throw std::runtime_error("Union: non-OCCT shape implementation");
+            operands.push_back(os);
+            occt.push_back(os->Occt());
+        }
 
-    for (size_t i = 1; i < shapes.size(); ++i) {
-        auto os = ShapeAsOcct(shapes[i]);
-        shape = BRepAlgoAPI_Fuse(shape, os->Occt()).Shape();
-    }
-    return WrapOcctShape(shape);
+        const auto mode = GetBooleanPrefilter();
+        if (mode == BooleanPrefilter::None) return WrapValidShape(FuseAll(std::move(occt)));
+
+        std::vector<Bounds> bounds;
+        bounds.reserve(operands.size());
+        for (const auto* os : operands) bounds.push_back(BoundsOf(*os, mode));
+        auto groups = OverlapGroups(bounds, mode);
+        if (groups.size() == 1) return WrapValidShape(FuseAll(std::move(occt)));
+
+        // Groups never touch: fuse within each group only and collect the results in a compound
+        CountFastPath();
+        std::vector<TopoDS_Shape> parts;
+        parts.reserve(groups.size());
+        bool valid = true;  // fused groups are; a single member passes through with the caller's validity
+        for (const auto& g : groups) {
+            if (g.size() == 1) {
+                const OcctShape& os = *operands[g.front()];
+                valid = valid && os.ValidityKnown() && os.IsValid();
+            }
+            std::vector<TopoDS_Shape> members;
+            members.reserve(g.size());
+            for (size_t i : g) members.push_back(occt[i]);
+            parts.push_back(FuseAll(std::move(members)));
+        }
+        return valid ? WrapValidShape(MakeCompound(parts)) : WrapOcctShape(MakeCompound(parts));
+    });
 }
 
 Shape Difference(const Shape& a, const Shape& b) {
-    auto oa = ShapeAsOcct(a), ob = ShapeAsOcct(b);
-    if (!oa || !ob) throw std::runtime_error("Difference: non-OCCT shape implementation");
-    BRepAlgoAPI_Cut algo(oa->Occt(), ob->Occt());
-    algo.SetRunParallel(true);
-    algo.Build();
-    if (!algo.IsDone()) throw std::runtime_error("Difference failed");
-    return WrapOcctShape(algo.Shape());
+    return Memoize(OpKey("Difference").Input(a).Input(b).Param(GetBooleanPrefilter()), [&]() {
+        auto oa = ShapeAsOcct(a), ob = ShapeAsOcct(b);
+        if (!oa || !ob) throw std::runtime_error("Difference: non-OCCT shape implementation");
+
+        const auto mode = GetBooleanPrefilter();
+        if (mode != BooleanPrefilter::None && Disjoint(BoundsOf(*oa, mode), BoundsOf(*ob, mode), mode)) {
+            CountFastPath();
+            return a;
+        }
+
+        BRepAlgoAPI_Cut algo;
+        algo.SetArguments(ListOf(oa->Occt()));
+        algo.SetTools(ListOf(ob->Occt()));
+        algo.SetNonDestructive(Standard_True);
+        WorkerLease lease(WorkerCount() - 1, LeaseMode::AllOrNothing);  // OCCT's pool runs at full width
+        algo.SetRunParallel(lease.Count() > 0);
+        OperationProgress progress("Difference");
+        algo.Build(progress.Range());
+        progress.ThrowIfCancelled();
+        if (!algo.IsDone()) throw std::runtime_error("Difference failed");
+        return algo.HasErrors() ? WrapOcctShape(algo.Shape()) : WrapValidShape(algo.Shape());
+    });
+}
+
+namespace {
+
+/// Tools cut together per batch when the single-pass cut fails.
+constexpr size_t kCutBatchSize = 16;
+
+bool CutOnce(const TopoDS_Shape& body, const TopTools_ListOfShape& tools, TopoDS_Shape& out) {
+    TopTools_ListOfShape objects;
+    objects.Append(body);
+    BRepAlgoAPI_Cut algo;
+    algo.SetArguments(objects);
+    algo.SetTools(tools);
+    algo.SetNonDestructive(Standard_True);
+    WorkerLease lease(WorkerCount() - 1, LeaseMode::AllOrNothing);  // OCCT's pool runs at full width
+    algo.SetRunParallel(lease.Count() > 0);
+    OperationProgress progress("Difference");
+    algo.Build(progress.Range());
+    progress.ThrowIfCancelled();
+    if (!algo.IsDone() || algo.HasErrors()) return false;
+    out = algo.Shape();
+    return true;
+}
+
+/// Cut spatially neighbouring tools in batches; a failing batch is retried tool by tool.
+TopoDS_Shape CutBatched(TopoDS_Shape body, std::vector<TopoDS_Shape> tools) {
+    SortSpatially(tools);
+    for (size_t first = 0; first < tools.size(); first += kCutBatchSize) {
+        const size_t last = std::min(first + kCutBatchSize, tools.size());
+        TopTools_ListOfShape batch;
+        for (size_t i = first; i < last; ++i) batch.Append(tools[i]);
+        if (CutOnce(body, batch, body)) continue;
+
+        for (size_t i = first; i < last; ++i) {
+            TopTools_ListOfShape single;
+            single.Append(tools[i]);
+            if (!CutOnce(body, single, body)) throw std::runtime_error("Difference failed");
+        }
+    }
+    return body;
+}
+
+}  // namespace
+
+Shape Difference(const Shape& a, const std::vector<Shape>& tools) {
+    return Memoize(OpKey("DifferenceMany").Input(a).Inputs(tools).Param(GetBooleanPrefilter()), [&]() {
+        auto oa = ShapeAsOcct(a);
+        if (!oa) throw std::runtime_error("Difference: non-OCCT shape implementation");
+        const TopoDS_Shape& body = oa->Occt();
+
+        // Drop tools which miss the body; hole patterns often reach past the part
+        const auto mode = GetBooleanPrefilter();
+        Bounds bodyBounds;
+        if (mode != BooleanPrefilter::None) bodyBounds = BoundsOf(*oa, mode);
+
+        std::vector<TopoDS_Shape> hits;
+        hits.reserve(tools.size());
+        for (const auto& t : tools) {
+            auto ot = ShapeAsOcct(t);
+            if (!ot) throw std::runtime_error("Difference: non-OCCT shape implementation");
+            if (mode != BooleanPrefilter::None && Disjoint(bodyBounds, BoundsOf(*ot, mode), mode)) continue;
+            hits.push_back(ot->Occt());
+        }
+        if (hits.empty()) {
+            if (!tools.empty()) CountFastPath();
+            return a;
+        }
+
+        TopTools_ListOfShape list;
+        for (const auto& t : hits) list.Append(t);
+        TopoDS_Shape result;
+        if (CutOnce(body, list, result)) return WrapValidShape(result);
+
+        LOG(WARN) << "Difference: single-pass cut with " << hits.size() << " tools failed, falling back to batches\n";
+        return WrapValidShape(CutBatched(body, std::move(hits)));
+    });
 }
 
 Shape Intersection(const Shape& a, const Shape& b) {
-    auto oa = ShapeAsOcct(a), ob = ShapeAsOcct(b);
-    if (!oa || !ob) throw std::runtime_error("Intersection: non-OCCT shape implementation");
-    BRepAlgoAPI_Common algo(oa->Occt(), ob->Occt());
-    algo.SetRunParallel(true);
-    algo.Build();
-    if (!algo.IsDone()) throw std::runtime_error("Intersection failed");
-    return WrapOcctShape(algo.Shape());
+    return Memoize(OpKey("Intersection").Input(a).Input(b).Param(GetBooleanPrefilter()), [&]() {
+        auto oa = ShapeAsOcct(a), ob = ShapeAsOcct(b);
+        if (!oa || !ob) throw std::runtime_error("Intersection: non-OCCT shape implementation");
+
+        const auto mode = GetBooleanPrefilter();
+        if (mode != BooleanPrefilter::None && Disjoint(BoundsOf(*oa, mode), BoundsOf(*ob, mode), mode)) {
+            CountFastPath();
+            return WrapOcctShape(MakeCompound({}));
+        }
+
+        BRepAlgoAPI_Common algo;
+        algo.SetArguments(ListOf(oa->Occt()));
+        algo.SetTools(ListOf(ob->Occt()));
+        algo.SetNonDestructive(Standard_True);
+        WorkerLease lease(WorkerCount() - 1, LeaseMode::AllOrNothing);  // OCCT's pool runs at full width
+        algo.SetRunParallel(lease.Count() > 0);
+        OperationProgress progress("Intersection");
+        algo.Build(progress.Range());
+        progress.ThrowIfCancelled();
+        if (!algo.IsDone()) throw std::runtime_error("Intersection failed");
+        return algo.HasErrors() ? WrapOcctShape(algo.Shape()) : WrapValidShape(algo.Shape());
+    });
 }
 
 // --- Transforms -------------------------------------------------------------
 
-static Shape apply_trsf(const Shape& s, const gp_Trsf& tr) {
+namespace {
+
+/// Rigid motions only move the shape: the result shares its TShape and just carries a new location.
+/// Scaling changes geometry and therefore always needs a copy, as does an explicit `copy` request.
+Shape apply_trsf(const Shape& s, const gp_Trsf& tr, bool copy = false) {
     auto os = ShapeAsOcct(s);
     if (!os) throw std::runtime_error("Transform: non-OCCT shape implementation");
-    BRepBuilderAPI_Transform t(os->Occt(), tr, /*copy*/ true);
-    t.Build();
-    if (!t.IsDone()) throw std::runtime_error("Transform failed");
-    return WrapOcctShape(t.Shape());
+
+    const OpKey key = OpKey("Transform").Input(s).Param(tr).Param(copy);
+    const bool rigid = std::abs(tr.ScaleFactor() - 1.0) <= gp::Resolution();
+    if (rigid && !copy) return Keyed(key, WrapMovedShape(os->Occt().Moved(TopLoc_Location(tr)), *os));
+
+    return Memoize(key, [&]() {
+        BRepBuilderAPI_Transform t(os->Occt(), tr, /*copy*/ true);
+        t.Build();
+        if (!t.IsDone()) throw std::runtime_error("Transform failed");
+        return WrapOcctShape(t.Shape());
+    });
 }
 
+gp_Trsf Rotation(const gp_Dir& axis, double deg) {
+    gp_Trsf tr;
+    tr.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), axis), deg * M_PI / 180.0);
+    return tr;
+}
+
+}  // namespace
+
 Shape Translate(const Shape& s, double dx, double dy, double dz) {
     gp_Trsf tr;
     tr.SetTranslation(gp_Vec(dx, dy, dz));
@@ -64,19 +436,15 @@ Shape Translate(const Shape& s, double dx, double dy, double dz) {
 }
 
 Shape RotateX(const Shape& s, double deg) {
-    gp_Trsf tr;
-    tr.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(1, 0, 0)), deg * M_PI / 180.0);
-    return apply_trsf(s, tr);
+    return apply_trsf(s, Rotation(gp_Dir(1, 0, 0), deg));
 }
+
 Shape RotateY(const Shape& s, double deg) {
-    gp_Trsf tr;
-    tr.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 1, 0)), deg * M_PI / 180.0);
-    return apply_trsf(s, tr);
+    return apply_trsf(s, Rotation(gp_Dir(0, 1, 0), deg));
 }
+
 Shape RotateZ(const Shape& s, double deg) {
-    gp_Trsf tr;
-    tr.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1)), deg * M_PI / 180.0);
-    return apply_trsf(s, tr);
+    return apply_trsf(s, Rotation(gp_Dir(0, 0, 1), deg));
 }
 
 Shape ScaleUniform(const Shape& s, double factor) {
@@ -84,5 +452,21 @@ Shape ScaleUniform(const Shape& s, double factor) {
     tr.SetScale(gp_Pnt(0, 0, 0), factor);
     return apply_trsf(s, tr);
 }
+
+Shape Apply(const Shape& s, const Transform& t, bool copy) {
+    // Same order as chaining the single ops: S, Rx, Ry, Rz, T
+    gp_Trsf tr;
+    if (t.scale != 1.0) tr.SetScale(gp_Pnt(0, 0, 0), t.scale);
+    if (t.rotateDeg.x != 0.0) tr.PreMultiply(Rotation(gp_Dir(1, 0, 0), t.rotateDeg.x));
+    if (t.rotateDeg.y != 0.0) tr.PreMultiply(Rotation(gp_Dir(0, 1, 0), t.rotateDeg.y));
+    if (t.rotateDeg.z != 0.0) tr.PreMultiply(Rotation(gp_Dir(0, 0, 1), t.rotateDeg.z));
+    if (t.translate.x != 0.0 || t.translate.y != 0.0 || t.translate.z != 0.0) {
+        gp_Trsf move;
+        move.SetTranslation(gp_Vec(t.translate.x, t.translate.y, t.translate.z));
+        tr.PreMultiply(move);
+    }
+    return apply_trsf(s, tr, copy);
+}
+
 }  // namespace ops
 }  // namespace ccad
@@ -0,0 +1,122 @@
+#include "ccad/ops/Pattern.hpp"
+
+#include <BRepBuilderAPI_Transform.hxx>
+#include <BRep_Builder.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Compound.hxx>
+#include <cmath>
+#include <gp.hxx>
+#include <gp_Ax1.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+#include <stdexcept>
+#include <vector>
+
+#include "ccad/ops/Boolean.hpp"
+#include "internal/OpCache.hpp"
+#include "internal/geom/ShapeHelper.hpp"
+
+namespace ccad {
+namespace ops {
+
+namespace {
+
+/// Place `s` once per transformation; all instances reference the same TShape.
+Shape Instantiate(const Shape& s, const std::vector<gp_Trsf>& placements, bool fuse, const char* op) {
+    auto os = ShapeAsOcct(s);
+    if (!os) throw std::runtime_error(std::string(op) + ": non-OCCT shape implementation");
+    const TopoDS_Shape& base = os->Occt();
+
+    if (fuse && placements.size() > 1) {
+        // Keyed like single transforms, so the fused result is found in the operation cache
+        std::vector<Shape> instances;
+        instances.reserve(placements.size());
+        for (const auto& tr : placements) {
+            instances.push_back(Keyed(OpKey("Transform").Input(s).Param(tr).Param(false),
+                                      WrapMovedShape(base.Moved(TopLoc_Location(tr)), *os)));
+        }
+        return Union(instances);
+    }
+
+    OpKey key(op);
+    key.Input(s).Param(placements.size());
+    for (const auto& tr : placements) key.Param(tr);
+
+    TopoDS_Compound comp;
+    BRep_Builder builder;
+    builder.MakeCompound(comp);
+    for (const auto& tr : placements) builder.Add(comp, base.Moved(TopLoc_Location(tr)));
+    return Keyed(key, WrapOcctShape(comp));
+}
+
+gp_Trsf Translation(double dx, double dy, double dz) {
+    gp_Trsf tr;
+    tr.SetTranslation(gp_Vec(dx, dy, dz));
+    return tr;
+}
+
+}  // namespace
+
+Shape LinearPattern(const Shape& s, int count, const Vec3& step, bool fuse) {
+    if (count < 1) throw std::runtime_error("LinearPattern: count must be >= 1");
+    std::vector<gp_Trsf> placements;
+    placements.reserve(count);
+    for (int i = 0; i < count; ++i) placements.push_back(Translation(i * step.x, i * step.y, i * step.z));
+    return Instantiate(s, placements, fuse, "LinearPattern");
+}
+
+Shape GridPattern(const Shape& s, int nx, double dx, int ny, double dy, bool fuse) {
+    if (nx < 1 || ny < 1) throw std::runtime_error("GridPattern: nx and ny must be >= 1");
+    std::vector<gp_Trsf> placements;
+    placements.reserve(static_cast<size_t>(nx) * ny);
+    for (int j = 0; j < ny; ++j) {
+        for (int i = 0; i < nx; ++i) placements.push_back(Translation(i * dx, j * dy, 0));
+    }
+    return Instantiate(s, placements, fuse, "GridPattern");
+}
+
+Shape PolarPattern(const Shape& s, int count, double radius, double startDeg, bool orient, bool fuse) {
+    if (count < 1) throw std::runtime_error("PolarPattern: count must be >= 1");
+    if (radius < 0) throw std::runtime_error("PolarPattern: radius must be >= 0");
+
+    std::vector<gp_Trsf> placements;
+    placements.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const double a = (startDeg + i * 360.0 / count) * M_PI / 180.0;
+        if (orient) {
+            // Move out along +X, then swing around Z
+            gp_Trsf tr;
+            tr.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1)), a);
+            tr.Multiply(Translation(radius, 0, 0));
+            placements.push_back(tr);
+        } else {
+            placements.push_back(Translation(radius * std::cos(a), radius * std::sin(a), 0));
+        }
+    }
+    return Instantiate(s, placements, fuse, "PolarPattern");
+}
+
+Shape Mirror(const Shape& s, const Plane3& plane) {
+    auto os = ShapeAsOcct(s);
+    if (!os) throw std::runtime_error("Mirror: non-OCCT shape implementation");
+    const Vec3& n = plane.normal;
+    if (std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z) <= gp::Resolution()) {
+        throw std::invalid_argument("Mirror: plane normal must not be zero");
+    }
+
+    gp_Trsf tr;
+    tr.SetMirror(gp_Ax2(gp_Pnt(plane.point.x, plane.point.y, plane.point.z),
+                        gp_Dir(plane.normal.x, plane.normal.y, plane.normal.z)));
+    return Memoize(OpKey("Mirror").Input(s).Param(tr), [&]() {
+        BRepBuilderAPI_Transform t(os->Occt(), tr, /*copy*/ true);
+        t.Build();
+        if (!t.IsDone()) throw std::runtime_error("Mirror failed");
+        return WrapOcctShape(t.Shape());
+    });
+}
+
+}  // namespace ops
+}  // namespace ccad
@@ -11,42 +11,53 @@
 
 #include "ccad/base/Exception.hpp"
 #include "ccad/base/Status.hpp"
+#include "internal/OpCache.hpp"
 #include "internal/geom/ShapeHelper.hpp"
 
 namespace ccad {
 namespace geom {
 Shape Box(double sx, double sy, double sz) {
-    if (sx <= 0 || sy <= 0 || sz <= 0) throw Exception("Box: sizes must be > 0", Status::ERROR_OCCT);
-    TopoDS_Shape s = BRepPrimAPI_MakeBox(sx, sy, sz).Shape();
-    return WrapOcctShape(s);
+    return Memoize(OpKey("Box").Param(sx).Param(sy).Param(sz), [&]() {
+        if (sx <= 0 || sy <= 0 || sz <= 0) throw Exception("Box: sizes must be > 0", Status::ERROR_OCCT);
+        TopoDS_Shape s = BRepPrimAPI_MakeBox(sx, sy, sz).Shape();
+        return WrapValidShape(s);
+    });
 }
 
 Shape Cylinder(double diameter, double height) {
-    if (diameter <= 0 || height <= 0) throw Exception("Cylinder: d,h must be > 0", Status::ERROR_OCCT);
-    gp_Ax2 ax(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1));  // Z-up
-    TopoDS_Shape s = BRepPrimAPI_MakeCylinder(ax, diameter * 0.5, height).Shape();
-    return WrapOcctShape(s);
+    return Memoize(OpKey("Cylinder").Param(diameter).Param(height), [&]() {
+        if (diameter <= 0 || height <= 0) throw Exception("Cylinder: d,h must be > 0", Status::ERROR_OCCT);
+        gp_Ax2 ax(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1));  // Z-up
+        TopoDS_Shape s = BRepPrimAPI_MakeCylinder(ax, diameter * 0.5, height).Shape();
+        return WrapValidShape(s);
+    });
 }
 
 Shape Cone(double diameter1, double diameter2, double height) {
-    if (diameter1 <= 0 || diameter2 <= 0 || height <= 0)
-        throw Exception("Cone: d1,d2,h must be > 0", Status::ERROR_OCCT);
-    gp_Ax2 ax(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1));  // Z-up
-    TopoDS_Shape s = BRepPrimAPI_MakeCone(ax, diameter1 * 0.5, diameter2 * 0.5, height).Shape();
-    return WrapOcctShape(s);
+    return Memoize(OpKey("Cone").Param(diameter1).Param(diameter2).Param(height), [&]() {
+        if (diameter1 <= 0 || diameter2 <= 0 || height <= 0)
+            throw Exception("Cone: d1,d2,h must be > 0", Status::ERROR_OCCT);
+        gp_Ax2 ax(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1));  // Z-up
+        TopoDS_Shape s = BRepPrimAPI_MakeCone(ax, diameter1 * 0.5, diameter2 * 0.5, height).Shape();
+        return WrapValidShape(s);
+    });
 }
 
 Shape Wedge(double dx, double dy, double dz, double ltx) {
-    if (dx <= 0 || dy <= 0 || dz <= 0 || ltx <= 0)
-        throw Exception("Wedge: dx,dy,dz,ltx must be > 0", Status::ERROR_OCCT);
-    TopoDS_Shape s = BRepPrimAPI_MakeWedge(dx, dy, dz, ltx).Shape();
-    return WrapOcctShape(s);
+    return Memoize(OpKey("Wedge").Param(dx).Param(dy).Param(dz).Param(ltx), [&]() {
+        if (dx <= 0 || dy <= 0 || dz <= 0 || ltx <= 0)
+            throw Exception("Wedge: dx,dy,dz,ltx must be > 0", Status::ERROR_OCCT);
+        TopoDS_Shape s = BRepPrimAPI_MakeWedge(dx, dy, dz, ltx).Shape();
+        return WrapValidShape(s);
+    });
 }
 
 Shape Sphere(double diameter) {
-    if (diameter <= 0) throw Exception("Sphere: diameter must be > 0", Status::ERROR_OCCT);
-    TopoDS_Shape s = BRepPrimAPI_MakeSphere(0.5 * diameter).Shape();
-    return WrapOcctShape(s);
+    return Memoize(OpKey("Sphere").Param(diameter), [&]() {
+        if (diameter <= 0) throw Exception("Sphere: diameter must be > 0", Status::ERROR_OCCT);
+        TopoDS_Shape s = BRepPrimAPI_MakeSphere(0.5 * diameter).Shape();
+        return WrapValidShape(s);
+    });
 }
 
 // internal helper function
@@ -64,11 +75,13 @@ static TopoDS_Face MakeRegularPolygonFace(int n, double acrossFlats) {
 }
 
 Shape HexPrism(double across_flats, double height) {
-    if (across_flats <= 0 || height <= 0)
-        throw Exception("HexPrism: across_flats,height must be > 0", Status::ERROR_OCCT);
-    TopoDS_Face face = MakeRegularPolygonFace(6, across_flats);
-    TopoDS_Shape s = BRepPrimAPI_MakePrism(face, gp_Vec(0, 0, height)).Shape();
-    return WrapOcctShape(s);
+    return Memoize(OpKey("HexPrism").Param(across_flats).Param(height), [&]() {
+        if (across_flats <= 0 || height <= 0)
+            throw Exception("HexPrism: across_flats,height must be > 0", Status::ERROR_OCCT);
+        TopoDS_Face face = MakeRegularPolygonFace(6, across_flats);
+        TopoDS_Shape s = BRepPrimAPI_MakePrism(face, gp_Vec(0, 0, height)).Shape();
+        return WrapValidShape(s);
+    });
 }
 }  // namespace geom
 }  // namespace ccad
@@ -0,0 +1,30 @@
+#include "ccad/base/Progress.hpp"
+
+#include "ccad/base/Exception.hpp"
+
+namespace ccad {
+
+static thread_local const OperationContext* t_Current = nullptr;
+
+OperationContext::OperationContext(CancelToken token, ProgressSink sink)
+    : m_Token(std::move(token)), m_Sink(std::move(sink)), m_Previous(t_Current) {
+    t_Current = this;
+}
+
+OperationContext::~OperationContext() {
+    t_Current = m_Previous;
+}
+
+const OperationContext* OperationContext::Current() {
+    return t_Current;
+}
+
+bool IsCancelled() {
+    return t_Current && t_Current->Token().IsCancelled();
+}
+
+void ThrowIfCancelled() {
+    if (IsCancelled()) throw Exception("Operation cancelled", Status::CANCELLED);
+}
+
+}  // namespace ccad
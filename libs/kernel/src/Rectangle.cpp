@@ -7,6 +7,7 @@
 #include <TopoDS_Face.hxx>
 #include <gp_Pnt.hxx>
 
+#include "internal/OpCache.hpp"
 #include "internal/geom/ShapeHelper.hpp"
 
 namespace ccad::sketch {
@@ -45,7 +46,7 @@ Shape Rectangle(double width, double height) {
     // Make face from wire
     TopoDS_Face face = BRepBuilderAPI_MakeFace(wireMaker.Wire());
 
-    return WrapOcctShape(face);
+    return Keyed(OpKey("Rectangle").Param(width).Param(height), WrapOcctShape(face));
 }
 
 }  // namespace ccad::sketch
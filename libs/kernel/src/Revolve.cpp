@@ -9,27 +9,30 @@
 #include <gp_Vec.hxx>
 
 #include "ccad/base/Math.hpp"
+#include "internal/OpCache.hpp"
 #include "internal/geom/ShapeHelper.hpp"
 
 namespace ccad::construct {
 
 Shape RevolveZ(const Shape& shp, double angleDeg) {
-    auto s = ShapeAsOcct(shp);
-    if (!s) throw std::runtime_error("Revolve: non-OCCT shape implementation");
+    return Memoize(OpKey("RevolveZ").Input(shp).Param(angleDeg), [&]() {
+        auto s = ShapeAsOcct(shp);
+        if (!s) throw std::runtime_error("Revolve: non-OCCT shape implementation");
 
-    const double angle = DegToRad(angleDeg);
-    gp_Ax1 axis(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1));
+        const double angle = DegToRad(angleDeg);
+        gp_Ax1 axis(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1));
 
-    TopAbs_ShapeEnum shapeType = s->Occt().ShapeType();
-    TopoDS_Shape out;
-    if (shapeType == TopAbs_FACE) {
-        out = BRepPrimAPI_MakeRevol(TopoDS::Face(s->Occt()), axis, angle).Shape();
-    } else if (shapeType == TopAbs_WIRE) {
-        out = BRepPrimAPI_MakeRevol(TopoDS::Wire(s->Occt()), axis, angle).Shape();
-    } else {
-        // Best-effort
-        out = BRepPrimAPI_MakeRevol(s->Occt(), axis, angle).Shape();
-    }
-    return WrapOcctShape(out);
+        TopAbs_ShapeEnum shapeType = s->Occt().ShapeType();
+        TopoDS_Shape out;
+        if (shapeType == TopAbs_FACE) {
+            out = BRepPrimAPI_MakeRevol(TopoDS::Face(s->Occt()), axis, angle).Shape();
+        } else if (shapeType == TopAbs_WIRE) {
+            out = BRepPrimAPI_MakeRevol(TopoDS::Wire(s->Occt()), axis, angle).Shape();
+        } else {
+            // Best-effort
+            out = BRepPrimAPI_MakeRevol(s->Occt(), axis, angle).Shape();
+        }
+        return WrapOcctShape(out);
+    });
 }
 }  // namespace ccad::construct
@@ -49,6 +49,7 @@ std::vector<Polyline2D> SectionWithPlane(const Shape& shape, const Plane3& plane
     try {
         BRepAlgoAPI_Section sec(s, plane, false);
         sec.Approximation(true);
+        sec.SetNonDestructive(Standard_True);  // the shape may be shared through the operation cache
         sec.Build();
         if (!sec.IsDone()) return out;
 
@@ -0,0 +1,59 @@
+#include "ccad/feature/Shell.hpp"
+
+#include <BRepOffsetAPI_MakeThickSolid.hxx>
+#include <BRepOffset_Mode.hxx>
+#include <GeomAbs_JoinType.hxx>
+#include <Standard_Failure.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <TopoDS.hxx>
+#include <ccad/base/Logger.hpp>
+
+#include "ccad/base/Exception.hpp"
+#include "ccad/base/Status.hpp"
+#include "internal/OpCache.hpp"
+#include "internal/Progress.hpp"
+#include "internal/geom/ShapeHelper.hpp"
+#include "internal/select/FaceTable.hpp"
+
+namespace ccad::feature {
+
+Shape Shell(const Shape& s, const select::FaceSet& openFaces, double thicknessMm) {
+    return Memoize(OpKey("Shell").Input(s).Param(openFaces.bits()).Param(thicknessMm), [&]() {
+        if (thicknessMm <= 0.0) throw Exception("Shell thickness must be > 0", Status::ERROR_OCCT);
+
+        auto os = ShapeAsOcct(s);
+        if (!os) throw std::runtime_error("Shell: non-OCCT shape implementation");
+        const TopoDS_Shape& source = os->Occt();
+        const PrivateCopy copy(source);  // the offset writes tolerances into its input
+        const TopoDS_Shape& shape = copy.Shape();
+
+        // index -> TopoDS_Face of the source: reuse the selector's map when it was built on this shape
+        TopTools_IndexedMapOfShape scratch;
+        const TopTools_IndexedMapOfShape& faceMap = select::FaceMapFor(openFaces, source, scratch);
+
+        TopTools_ListOfShape remove;
+        for (size_t idx : openFaces.indices()) {
+            const int idx1 = static_cast<int>(idx) + 1;
+            if (idx1 > faceMap.Extent()) continue;
+            remove.Append(TopoDS::Face(copy.Map(faceMap.FindKey(idx1))));
+        }
+
+        try {
+            BRepOffsetAPI_MakeThickSolid mk;
+            OperationProgress progress("Shell");
+            // negative offset: walls grow inward, outer dimensions stay
+            mk.MakeThickSolidByJoin(shape, remove, -thicknessMm, 1e-4, BRepOffset_Skin, Standard_False, Standard_False,
+                                    GeomAbs_Intersection, /*RemoveIntEdges*/ Standard_False, progress.Range());
+            mk.Build();
+            progress.ThrowIfCancelled();
+            if (!mk.IsDone()) throw Exception("Shell: offset failed", Status::ERROR_OCCT);
+            return WrapOcctShape(mk.Shape());
+        } catch (const Standard_Failure& e) {
+            LOG(ERROR) << "[shell] OpenCascade error: " << e.GetMessageString();
+            throw Exception(std::string("Shell: ") + e.GetMessageString(), Status::ERROR_OCCT);
+        }
+    });
+}
+
+}  // namespace ccad::feature
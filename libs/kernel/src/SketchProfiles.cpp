@@ -9,6 +9,7 @@
 #include <cmath>
 #include <gp_Pnt.hxx>
 
+#include "internal/OpCache.hpp"
 #include "internal/geom/ShapeHelper.hpp"
 
 namespace ccad::sketch {
@@ -36,6 +37,14 @@ static std::vector<Vec2> dedupeConsecutive(const std::vector<Vec2>& in) {
     return out;
 }
 
+// Operation key over the input points
+static OpKey PointsKey(const char* op, const std::vector<Vec2>& pts) {
+    OpKey key(op);
+    key.Param(pts.size());
+    for (const auto& p : pts) key.Param(p.x).Param(p.y);
+    return key;
+}
+
 // Make edges from a list of 3D points (open poly)
 static void addPolylineEdges(BRepBuilderAPI_MakeWire& w, const std::vector<gp_Pnt>& pts) {
     for (std::size_t i = 1; i < pts.size(); ++i) {
@@ -66,7 +75,7 @@ Shape PolyXY(const std::vector<Vec2>& ptsIn) {
 
     // Create face from wire
     TopoDS_Face face = BRepBuilderAPI_MakeFace(wire.Wire());
-    return WrapOcctShape(face);
+    return Keyed(PointsKey("PolyXY", ptsIn), WrapOcctShape(face));
 }
 
 Shape ProfileXZ(const std::vector<Vec2>& ptsIn, bool closed) {
@@ -90,10 +99,10 @@ Shape ProfileXZ(const std::vector<Vec2>& ptsIn, bool closed) {
     if (closed) {
         // planar face
         TopoDS_Face f = BRepBuilderAPI_MakeFace(wire).Face();
-        return WrapOcctShape(f);
+        return Keyed(PointsKey("ProfileXZ", ptsIn).Param(closed), WrapOcctShape(f));
     } else {
         // open wire
-        return WrapOcctShape(wire.Wire());
+        return Keyed(PointsKey("ProfileXZ", ptsIn).Param(closed), WrapOcctShape(wire.Wire()));
     }
 }
 
@@ -0,0 +1,51 @@
+#include "ccad/base/Stats.hpp"
+
+#include "internal/Stats.hpp"
+
+namespace ccad {
+
+KernelCounters& Counters() {
+    static KernelCounters counters;
+    return counters;
+}
+
+ThreadOpCacheCounters& ThreadCounters() {
+    thread_local ThreadOpCacheCounters counters;
+    return counters;
+}
+
+KernelStats GetKernelStats() {
+    const auto& c = Counters();
+    KernelStats s;
+    s.meshCacheHits = c.meshCacheHits.load(std::memory_order_relaxed);
+    s.meshCacheMisses = c.meshCacheMisses.load(std::memory_order_relaxed);
+    s.booleanFastPaths = c.booleanFastPaths.load(std::memory_order_relaxed);
+    s.validityChecks = c.validityChecks.load(std::memory_order_relaxed);
+    s.opCacheHits = c.opCacheHits.load(std::memory_order_relaxed);
+    s.opCacheMisses = c.opCacheMisses.load(std::memory_order_relaxed);
+    s.opCacheSavedMs = static_cast<double>(c.opCacheSavedNs.load(std::memory_order_relaxed)) * 1e-6;
+    return s;
+}
+
+KernelStats GetThreadKernelStats() {
+    const auto& t = ThreadCounters();
+    KernelStats s;
+    s.opCacheHits = t.hits;
+    s.opCacheMisses = t.misses;
+    s.opCacheSavedMs = static_cast<double>(t.savedNs) * 1e-6;
+    return s;
+}
+
+void ResetKernelStats() {
+    auto& c = Counters();
+    c.meshCacheHits = 0;
+    c.meshCacheMisses = 0;
+    c.booleanFastPaths = 0;
+    c.validityChecks = 0;
+    c.opCacheHits = 0;
+    c.opCacheMisses = 0;
+    c.opCacheSavedNs = 0;
+    ThreadCounters() = ThreadOpCacheCounters{};
+}
+
+}  // namespace ccad
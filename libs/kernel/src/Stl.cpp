@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <ccad/base/Logger.hpp>
+#include <ccad/io/Stl.hpp>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "internal/Execution.hpp"
+#include "internal/ThreadPool.hpp"
+
+namespace ccad::io {
+
+namespace {
+
+constexpr size_t kHeaderSize = 80;
+constexpr size_t kRecordSize = 50;  // normal + 3 vertices (12 floats) + attribute byte count
+
+/// One STL facet in single precision, as it ends up in the file.
+struct Facet {
+    float n[3];
+    float v[3][3];
+};
+
+// STL is little-endian by definition; write byte-wise so the output does not depend on the host.
+inline void PutU32(char* p, uint32_t v) {
+    p[0] = static_cast<char>(v & 0xff);
+    p[1] = static_cast<char>((v >> 8) & 0xff);
+    p[2] = static_cast<char>((v >> 16) & 0xff);
+    p[3] = static_cast<char>((v >> 24) & 0xff);
+}
+
+inline void PutF32(char* p, float f) {
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    PutU32(p, u);
+}
+
+Facet MakeFacet(const geom::TriMesh& mesh, size_t tri) {
+    const size_t nbNodes = mesh.positions.size();
+    const unsigned* idx = &mesh.indices[3 * tri];
+    if (idx[0] >= nbNodes || idx[1] >= nbNodes || idx[2] >= nbNodes) {
+        throw std::out_of_range("WriteSTL: triangle index out of range");
+    }
+    const Vec3& a = mesh.positions[idx[0]];
+    const Vec3& b = mesh.positions[idx[1]];
+    const Vec3& c = mesh.positions[idx[2]];
+
+    const double ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+    const double vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+    double nx = uy * vz - uz * vy;
+    double ny = uz * vx - ux * vz;
+    double nz = ux * vy - uy * vx;
+    double len = std::sqrt(nx * nx + ny * ny + nz * nz);
+    if (len == 0.0 && mesh.normals.size() == nbNodes) {
+        // Degenerate facet: fall back to the averaged surface normals
+        const Vec3& na = mesh.normals[idx[0]];
+        const Vec3& nb = mesh.normals[idx[1]];
+        const Vec3& nc = mesh.normals[idx[2]];
+        nx = na.x + nb.x + nc.x;
+        ny = na.y + nb.y + nc.y;
+        nz = na.z + nb.z + nc.z;
+        len = std::sqrt(nx * nx + ny * ny + nz * nz);
+    }
+    if (len > 0.0) {
+        nx /= len;
+        ny /= len;
+        nz /= len;
+    }
+
+    Facet f;
+    f.n[0] = static_cast<float>(nx);
+    f.n[1] = static_cast<float>(ny);
+    f.n[2] = static_cast<float>(nz);
+    const Vec3* verts[3] = {&a, &b, &c};
+    for (int k = 0; k < 3; ++k) {
+        f.v[k][0] = static_cast<float>(verts[k]->x);
+        f.v[k][1] = static_cast<float>(verts[k]->y);
+        f.v[k][2] = static_cast<float>(verts[k]->z);
+    }
+    return f;
+}
+
+void FormatBinary(const geom::TriMesh& mesh, size_t begin, size_t end, std::string& out) {
+    out.resize((end - begin) * kRecordSize);
+    char* p = out.data();
+    for (size_t t = begin; t < end; ++t) {
+        const Facet f = MakeFacet(mesh, t);
+        for (int k = 0; k < 3; ++k, p += 4) PutF32(p, f.n[k]);
+        for (int v = 0; v < 3; ++v) {
+            for (int k = 0; k < 3; ++k, p += 4) PutF32(p, f.v[v][k]);
+        }
+        *p++ = 0;  // attribute byte count
+        *p++ = 0;
+    }
+}
+
+void FormatAscii(const geom::TriMesh& mesh, size_t begin, size_t end, std::string& out) {
+    out.clear();
+    out.reserve((end - begin) * 260);
+    char line[128];
+    for (size_t t = begin; t < end; ++t) {
+        const Facet f = MakeFacet(mesh, t);
+        int n = std::snprintf(line, sizeof(line), "  facet normal %e %e %e\n    outer loop\n", f.n[0], f.n[1],
+                              f.n[2]);
+        out.append(line, static_cast<size_t>(n));
+        for (int v = 0; v < 3; ++v) {
+            n = std::snprintf(line, sizeof(line), "      vertex %e %e %e\n", f.v[v][0], f.v[v][1], f.v[v][2]);
+            out.append(line, static_cast<size_t>(n));
+        }
+        out.append("    endloop\n  endfacet\n");
+    }
+}
+
+}  // namespace
+
+bool WriteSTL(const geom::TriMesh& mesh, const std::string& path, const StlOptions& opt) {
+    if (mesh.indices.size() % 3 != 0) {
+        LOG(ERROR) << "WriteSTL: index count is not a multiple of 3";
+        return false;
+    }
+    const size_t nbTris = mesh.indices.size() / 3;
+    const bool ascii = opt.format == StlFormat::Ascii;
+    if (!ascii && nbTris > std::numeric_limits<uint32_t>::max()) {
+        LOG(ERROR) << "WriteSTL: too many triangles for binary STL: " << nbTris;
+        return false;
+    }
+
+    std::vector<char> streamBuffer(std::max<size_t>(opt.bufferBytes, 4096));
+    std::ofstream f;
+    f.rdbuf()->pubsetbuf(streamBuffer.data(), static_cast<std::streamsize>(streamBuffer.size()));
+    f.open(path, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        LOG(ERROR) << "Failed to write STL: " << path;
+        return false;
+    }
+
+    if (ascii) {
+        f << "solid ccad\n";
+    } else {
+        char header[kHeaderSize + 4] = {};
+        std::snprintf(header, kHeaderSize, "CodeCAD binary STL");
+        PutU32(header + kHeaderSize, static_cast<uint32_t>(nbTris));
+        f.write(header, sizeof(header));
+    }
+
+    const size_t chunk = std::max<size_t>(1, opt.chunkTriangles);
+    const size_t nbChunks = (nbTris + chunk - 1) / chunk;
+    auto format = [&mesh, chunk, nbTris, ascii](size_t c) {
+        std::string buf;
+        const size_t b = c * chunk;
+        const size_t e = std::min(nbTris, b + chunk);
+        if (ascii)
+            FormatAscii(mesh, b, e, buf);
+        else
+            FormatBinary(mesh, b, e, buf);
+        return buf;
+    };
+
+    try {
+        std::shared_ptr<ThreadPool> pool = ThreadPool::Shared();
+        WorkerLease lease(nbChunks > 1 && !ThreadPool::InWorker() ? pool->Size() : 0);
+        if (lease.Count() == 0) {
+            for (size_t c = 0; c < nbChunks; ++c) {
+                const std::string buf = format(c);
+                f.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+            }
+        } else {
+            // Keep a bounded window of chunks in flight; the calling thread writes them in order
+            // while the leased workers format the next ones.
+            const size_t window = lease.Count();
+            std::deque<std::future<std::string>> inFlight;
+            size_t next = 0;
+            auto submit = [&]() {
+                inFlight.push_back(pool->Submit([&format, c = next]() { return format(c); }));
+                ++next;
+            };
+            while (next < nbChunks && inFlight.size() < window) submit();
+
+            try {
+                while (!inFlight.empty()) {
+                    const std::string buf = inFlight.front().get();
+                    inFlight.pop_front();
+                    if (next < nbChunks) submit();
+                    f.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+                }
+            } catch (...) {
+                for (auto& pending : inFlight) pending.wait();  // tasks reference `format`
+                throw;
+            }
+        }
+    } catch (const std::exception& e) {
+        LOG(ERROR) << "Failed to write STL: " << path << " (" << e.what() << ")";
+        return false;
+    }
+
+    if (ascii) f << "endsolid ccad\n";
+    f.flush();
+    if (!f) {
+        LOG(ERROR) << "Failed to write STL: " << path;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace ccad::io
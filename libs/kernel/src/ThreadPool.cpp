@@ -0,0 +1,114 @@
+#include "internal/ThreadPool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+#include "internal/Execution.hpp"
+
+namespace ccad {
+
+static thread_local bool t_InWorker = false;
+
+ThreadPool::ThreadPool(size_t workers) {
+    workers = std::max<size_t>(1, workers);
+    m_Workers.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        m_Workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Cv.notify_all();
+    for (auto& t : m_Workers) {
+        if (t.joinable()) t.join();
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    t_InWorker = true;
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Cv.wait(lock, [this]() { return m_Stop || !m_Queue.empty(); });
+            if (m_Stop && m_Queue.empty()) return;
+            task = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        task();
+    }
+}
+
+bool ThreadPool::InWorker() {
+    return t_InWorker;
+}
+
+static std::mutex s_SharedMutex;
+static std::shared_ptr<ThreadPool> s_Shared;
+
+std::shared_ptr<ThreadPool> ThreadPool::Shared() {
+    const size_t budget = WorkerCount();
+    std::lock_guard<std::mutex> lock(s_SharedMutex);
+    if (!s_Shared) s_Shared = std::make_shared<ThreadPool>(budget > 1 ? budget - 1 : 1);
+    return s_Shared;
+}
+
+void ThreadPool::Resize(size_t budget) {
+    std::shared_ptr<ThreadPool> old;
+    {
+        std::lock_guard<std::mutex> lock(s_SharedMutex);
+        if (!s_Shared || s_Shared->Size() == (budget > 1 ? budget - 1 : 1)) return;
+        old.swap(s_Shared);  // recreated on the next Shared() call
+    }
+    // `old` joins its workers here, outside the lock, unless a running ParallelFor still holds it
+}
+
+void ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& fn) {
+    if (end <= begin) return;
+    grain = std::max<size_t>(1, grain);
+    const size_t n = end - begin;
+
+    const size_t wanted = (n + grain - 1) / grain - 1;  // chunks besides the caller's own
+    if (wanted == 0 || ThreadPool::InWorker()) {
+        fn(begin, end);
+        return;
+    }
+    std::shared_ptr<ThreadPool> pool = ThreadPool::Shared();
+    WorkerLease lease(std::min(wanted, pool->Size()));
+    if (lease.Count() == 0) {
+        fn(begin, end);
+        return;
+    }
+    const size_t chunks = lease.Count() + 1;
+
+    const size_t step = (n + chunks - 1) / chunks;
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunks - 1);
+    for (size_t c = 1; c < chunks; ++c) {
+        const size_t b = begin + c * step;
+        const size_t e = std::min(end, b + step);
+        if (b >= e) break;
+        pending.push_back(pool->Submit([&fn, b, e]() { fn(b, e); }));
+    }
+
+    std::exception_ptr error;
+    try {
+        fn(begin, std::min(end, begin + step));
+    } catch (...) {
+        error = std::current_exception();
+    }
+    for (auto& f : pending) {
+        try {
+            f.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace ccad
@@ -18,6 +18,7 @@
 #include <Geom_BSplineCurve.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopTools_ListOfShape.hxx>
 #include <TopoDS.hxx>
 #include <algorithm>
 #include <cmath>
@@ -32,6 +33,9 @@
 #include <map>
 #include <stdexcept>
 
+#include "internal/Execution.hpp"
+#include "internal/OpCache.hpp"
+#include "internal/Progress.hpp"
 #include "internal/geom/ShapeHelper.hpp"
 
 const double TOLERANCE = 1e-3;
@@ -54,9 +58,21 @@ static inline double CalculateBase(double flankAngleDeg, double depth) {
     return 2.0 * depth * std::tan(half);
 }
 
+/// Single-argument list for the boolean builders.
+static TopTools_ListOfShape ListOf(const TopoDS_Shape& s) {
+    TopTools_ListOfShape list;
+    list.Append(s);
+    return list;
+}
+
+// The two-shape constructors build right away, before parallelism and fuzzy value are set
 TopoDS_Shape Fuse(const TopoDS_Shape& a, const TopoDS_Shape& b) {
-    BRepAlgoAPI_Fuse op(a, b);
-    op.SetRunParallel(true);
+    BRepAlgoAPI_Fuse op;
+    op.SetArguments(ListOf(a));
+    op.SetTools(ListOf(b));
+    op.SetNonDestructive(Standard_True);  // inputs may be shared through the operation cache
+    WorkerLease lease(WorkerCount() - 1, LeaseMode::AllOrNothing);
+    op.SetRunParallel(lease.Count() > 0);
     op.SetFuzzyValue(TOLERANCE);
     op.Build();
     if (!op.IsDone()) {
@@ -67,9 +83,14 @@ TopoDS_Shape Fuse(const TopoDS_Shape& a, const TopoDS_Shape& b) {
 }
 
 TopoDS_Shape Cut(const TopoDS_Shape& a, const TopoDS_Shape& b) {
-    BRepAlgoAPI_Cut op(a, b);
-    op.SetRunParallel(true);
+    BRepAlgoAPI_Cut op;
+    op.SetArguments(ListOf(a));
+    op.SetTools(ListOf(b));
+    op.SetNonDestructive(Standard_True);
+    WorkerLease lease(WorkerCount() - 1, LeaseMode::AllOrNothing);
+    op.SetRunParallel(lease.Count() > 0);
     op.SetFuzzyValue(TOLERANCE);
+    op.Build();
     if (!op.IsDone()) throw std::runtime_error("Cut failed");
     return op.Shape();
 }
@@ -225,7 +246,9 @@ TopoDS_Shape SweepAlongHelix(const TopoDS_Wire& spine, const TopoDS_Wire& sectio
     BRepOffsetAPI_MakePipeShell pipe(spine);
     pipe.SetMode(/*isFrenet*/ true);
     pipe.Add(section);
-    pipe.Build();
+    OperationProgress progress("Thread");
+    pipe.Build(progress.Range());
+    progress.ThrowIfCancelled();
     if (!pipe.IsDone()) throw std::runtime_error("PipeShell build failed");
     pipe.MakeSolid();
     return pipe.Shape();
@@ -235,6 +258,14 @@ static bool IsLeft(const ThreadSpec& s) {
     return s.handedness == Handedness::Left;
 }
 
+/// Operation key over a (normalized) thread specification.
+static OpKey ThreadKey(const char* op, const ThreadSpec& s) {
+    OpKey key(op);
+    key.Param(s.fitDiameter).Param(s.pitch).Param(s.depth).Param(s.flankAngleDeg).Param(s.clearance);
+    key.Param(s.handedness).Param(s.tip).Param(s.tipCutRatio).Param(s.segmentsPerTurn);
+    return key;
+}
+
 // ---------------- public API ----------------
 
 Shape ThreadOps::ThreadExternalRod(const ThreadSpec& inSpec, double rodLength, double threadLength,
@@ -255,37 +286,41 @@ Shape ThreadOps::ThreadExternalRod(const ThreadSpec& inSpec, double rodLength, d
     // Base rod (full rodLength)
     const double R_minor = 0.5 * spec.fitDiameter - spec.clearance + eps;
     majorDiameter = (R_minor + spec.depth) * 2.0;
-    TopoDS_Shape rod = BRepPrimAPI_MakeCylinder(R_minor, rodLength).Shape();
 
-    // Helix for threaded section (0..L)
-    Handle(Geom_Curve) helix = MakeHelixCurve(R_pitch, spec.pitch, L, IsLeft(spec), spec.segmentsPerTurn);
-    TopoDS_Wire helixWire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(helix));
+    // Out-parameters are set above, so only the geometry goes through the operation cache
+    return Memoize(ThreadKey("ThreadExternalRod", spec).Param(rodLength).Param(threadLength), [&]() {
+        TopoDS_Shape rod = BRepPrimAPI_MakeCylinder(R_minor, rodLength).Shape();
+
+        // Helix for threaded section (0..L)
+        Handle(Geom_Curve) helix = MakeHelixCurve(R_pitch, spec.pitch, L, IsLeft(spec), spec.segmentsPerTurn);
+        TopoDS_Wire helixWire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(helix));
 
-    // Profile in local YZ, then rotate/translate into world so that local +Y -> +X (radial)
-    TopoDS_Wire profileYZ = MakeVProfileYZ(spec.depth, spec.flankAngleDeg, spec.tip, spec.tipCutRatio);
+        // Profile in local YZ, then rotate/translate into world so that local +Y -> +X (radial)
+        TopoDS_Wire profileYZ = MakeVProfileYZ(spec.depth, spec.flankAngleDeg, spec.tip, spec.tipCutRatio);
 
-    gp_Trsf rotZ;
-    rotZ.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1)), -M_PI / 2.0);
-    gp_Trsf shift;
-    const double base = CalculateBase(spec.flankAngleDeg, spec.depth);
+        gp_Trsf rotZ;
+        rotZ.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1)), -M_PI / 2.0);
+        gp_Trsf shift;
+        const double base = CalculateBase(spec.flankAngleDeg, spec.depth);
 
-    shift.SetTranslation(gp_Vec(R_pitch - 0.5 * spec.depth, 0, -base * 0.5));
-    TopoDS_Wire profilePlaced = TransformWire(profileYZ, shift * rotZ);
+        shift.SetTranslation(gp_Vec(R_pitch - 0.5 * spec.depth, 0, -base * 0.5));
+        TopoDS_Wire profilePlaced = TransformWire(profileYZ, shift * rotZ);
 
-    // Sweep → ridge volume for 0..L
-    TopoDS_Shape ridges = SweepAlongHelix(helixWire, profilePlaced);
+        // Sweep → ridge volume for 0..L
+        TopoDS_Shape ridges = SweepAlongHelix(helixWire, profilePlaced);
 
-    // Cut top and bottom profile, because it is overhanging
-    const double big = std::max({R_minor, spec.depth}) * 4.0 + 10.0;
-    TopoDS_Shape clip = BRepPrimAPI_MakeBox(gp_Pnt(-big, -big, 0), gp_Pnt(+big, +big, L)).Shape();
+        // Cut top and bottom profile, because it is overhanging
+        const double big = std::max({R_minor, spec.depth}) * 4.0 + 10.0;
+        TopoDS_Shape clip = BRepPrimAPI_MakeBox(gp_Pnt(-big, -big, 0), gp_Pnt(+big, +big, L)).Shape();
 
-    // Intersection (Common) statt Cut/Fuse:
-    TopoDS_Shape ridgesClipped = BRepAlgoAPI_Common(ridges, clip).Shape();
+        // Intersection (Common) statt Cut/Fuse:
+        TopoDS_Shape ridgesClipped = BRepAlgoAPI_Common(ridges, clip).Shape();
 
-    // Fuse ridges only onto the threaded section: we fuse full rods; simple and robust
-    TopoDS_Shape threaded = Fuse(rod, ridgesClipped);
+        // Fuse ridges only onto the threaded section: we fuse full rods; simple and robust
+        TopoDS_Shape threaded = Fuse(rod, ridgesClipped);
 
-    return WrapOcctShape(threaded);
+        return WrapOcctShape(threaded);
+    });
 }
 
 Shape ThreadOps::ThreadInternalCutter(const ThreadSpec& inSpec, double threadLength, double& boreHoleDiameter) {
@@ -308,22 +343,24 @@ Shape ThreadOps::ThreadInternalCutter(const ThreadSpec& inSpec, double threadLen
         boreHoleDiameter += spec.tipCutRatio * spec.depth * 2.0;
     }
 
-    Handle(Geom_Curve) helix = MakeHelixCurve(R_pitch, spec.pitch, L, IsLeft(spec), spec.segmentsPerTurn);
-    TopoDS_Wire helixWire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(helix));
+    return Memoize(ThreadKey("ThreadInternalCutter", spec).Param(threadLength), [&]() {
+        Handle(Geom_Curve) helix = MakeHelixCurve(R_pitch, spec.pitch, L, IsLeft(spec), spec.segmentsPerTurn);
+        TopoDS_Wire helixWire = BRepBuilderAPI_MakeWire(BRepBuilderAPI_MakeEdge(helix));
 
-    TopoDS_Wire profileYZ = MakeVProfileYZ(spec.depth, spec.flankAngleDeg, spec.tip, spec.tipCutRatio);
+        TopoDS_Wire profileYZ = MakeVProfileYZ(spec.depth, spec.flankAngleDeg, spec.tip, spec.tipCutRatio);
 
-    gp_Trsf rotZ;
-    rotZ.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1)), M_PI / 2.0);
-    gp_Trsf shift;
-    const double base = CalculateBase(spec.flankAngleDeg, spec.depth);
-    shift.SetTranslation(
-        gp_Vec(-R_pitch + spec.tipCutRatio * spec.depth * 0.5 - eps, 0, spec.pitch * 0.5 - base * 0.5));
-    TopoDS_Wire profilePlaced = TransformWire(profileYZ, shift * rotZ);
+        gp_Trsf rotZ;
+        rotZ.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(0, 0, 1)), M_PI / 2.0);
+        gp_Trsf shift;
+        const double base = CalculateBase(spec.flankAngleDeg, spec.depth);
+        shift.SetTranslation(
+            gp_Vec(-R_pitch + spec.tipCutRatio * spec.depth * 0.5 - eps, 0, spec.pitch * 0.5 - base * 0.5));
+        TopoDS_Wire profilePlaced = TransformWire(profileYZ, shift * rotZ);
 
-    TopoDS_Shape cutter = SweepAlongHelix(helixWire, profilePlaced);
+        TopoDS_Shape cutter = SweepAlongHelix(helixWire, profilePlaced);
 
-    return WrapOcctShape(cutter);
+        return WrapOcctShape(cutter);
+    });
 }
 }  // namespace mech
 }  // namespace ccad
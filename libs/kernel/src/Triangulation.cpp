@@ -1,10 +1,15 @@
 #include <ccad/geom/Triangulation.hpp>
 
 // OCCT
+#include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
+#include <BRepLib_ToolTriangulatedShape.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
 #include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <IMeshTools_Parameters.hxx>
 #include <Poly_Array1OfTriangle.hxx>
 #include <Poly_Triangulation.hxx>
 #include <Precision.hxx>
@@ -12,9 +17,19 @@
 #include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Shape.hxx>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "ccad/base/Logger.hpp"
 #include "ccad/base/Math.hpp"
+#include "internal/Execution.hpp"
+#include "internal/Progress.hpp"
+#include "internal/ThreadPool.hpp"
+#include "internal/geom/MeshCache.hpp"
 #include "internal/geom/OcctShape.hpp"
 #include "internal/geom/ShapeHelper.hpp"
 
@@ -59,59 +74,289 @@ std::ostream& operator<<(std::ostream& os, const TriMesh& mesh) {
     return os;
 }
 
-TriMesh Triangulate(const Shape& shape, const geom::TriangulationParams& p) {
-    auto s = ShapeAsOcct(shape);
-    if (!s) throw std::runtime_error("Triangulate: non-OCCT shape implementation");
+/**
+ * Merge coincident vertices whose normals differ by less than the crease angle; the merged normal
+ * is the normalized sum. Candidates are found through a hash of the quantized position (3x3x3 cells).
+ */
+static void WeldVertices(TriMesh& mesh, double creaseAngleDeg) {
+    constexpr double kCell = 1e-5;  // weld tolerance [mm]
+    const double minDot = std::cos(DegToRad(creaseAngleDeg));
+    const bool hasNormals = mesh.normals.size() == mesh.positions.size();
+
+    struct CellHash {
+        size_t operator()(const std::array<int64_t, 3>& c) const {
+            return static_cast<size_t>(c[0] * 73856093) ^ static_cast<size_t>(c[1] * 19349663) ^
+                   static_cast<size_t>(c[2] * 83492791);
+        }
+    };
+    std::unordered_map<std::array<int64_t, 3>, std::vector<unsigned>, CellHash> grid;
+    grid.reserve(mesh.positions.size());
 
-    auto os = s->Occt();
+    auto cellOf = [](const Vec3& v) {
+        return std::array<int64_t, 3>{static_cast<int64_t>(std::floor(v.x / kCell)),
+                                      static_cast<int64_t>(std::floor(v.y / kCell)),
+                                      static_cast<int64_t>(std::floor(v.z / kCell))};
+    };
 
-    BRepMesh_IncrementalMesh mesher(os, p.linearDeflection, false, DegToRad(p.angularDeflectionDeg), p.parallel);
-    mesher.Perform();
+    std::vector<Vec3> positions, normals;
+    positions.reserve(mesh.positions.size());
+    normals.reserve(mesh.normals.size());
+    std::vector<unsigned> remap(mesh.positions.size());
 
-    TriMesh out;
-    int totalNumTriangles{0};
+    for (size_t i = 0; i < mesh.positions.size(); ++i) {
+        const Vec3& v = mesh.positions[i];
+        const auto c = cellOf(v);
+
+        long found = -1;
+        for (int dx = -1; dx <= 1 && found < 0; ++dx) {
+            for (int dy = -1; dy <= 1 && found < 0; ++dy) {
+                for (int dz = -1; dz <= 1 && found < 0; ++dz) {
+                    auto it = grid.find({c[0] + dx, c[1] + dy, c[2] + dz});
+                    if (it == grid.end()) continue;
+                    for (unsigned w : it->second) {
+                        const Vec3& q = positions[w];
+                        if (std::abs(q.x - v.x) > kCell || std::abs(q.y - v.y) > kCell || std::abs(q.z - v.z) > kCell)
+                            continue;
+                        if (hasNormals) {
+                            // Compare against the direction of the welded (summed) normal
+                            const Vec3& a = normals[w];
+                            const Vec3& b = mesh.normals[i];
+                            const double la = std::sqrt(a.x * a.x + a.y * a.y + a.z * a.z);
+                            if (la > 0.0 && (a.x * b.x + a.y * b.y + a.z * b.z) / la < minDot) continue;
+                        }
+                        found = static_cast<long>(w);
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (found >= 0) {
+            remap[i] = static_cast<unsigned>(found);
+            if (hasNormals) {
+                Vec3& a = normals[static_cast<size_t>(found)];
+                const Vec3& b = mesh.normals[i];
+                a = Vec3(a.x + b.x, a.y + b.y, a.z + b.z);
+            }
+            continue;
+        }
+        remap[i] = static_cast<unsigned>(positions.size());
+        grid[c].push_back(remap[i]);
+        positions.push_back(v);
+        if (hasNormals) normals.push_back(mesh.normals[i]);
+    }
+
+    for (auto& n : normals) {
+        const double len = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        if (len > 0.0) n = Vec3(n.x / len, n.y / len, n.z / len);
+    }
+
+    // Remap and drop triangles which collapsed while welding
+    std::vector<unsigned> indices;
+    indices.reserve(mesh.indices.size());
+    for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+        const unsigned a = remap[mesh.indices[t]], b = remap[mesh.indices[t + 1]], c = remap[mesh.indices[t + 2]];
+        if (a == b || b == c || a == c) continue;
+        indices.push_back(a);
+        indices.push_back(b);
+        indices.push_back(c);
+    }
 
+    mesh.positions.swap(positions);
+    mesh.normals.swap(normals);
+    mesh.indices.swap(indices);
+}
+
+static TriMesh MeshShape(const TopoDS_Shape& source, const geom::TriangulationParams& p) {
+    // Mesh a topology copy (the surfaces are shared read-only): the source TShapes are shared through the
+    // operation cache and between threads, and BRepMesh would keep any finer triangulation left on them.
+    const TopoDS_Shape os = BRepBuilderAPI_Copy(source, /*copyGeom*/ Standard_False, /*copyMesh*/ Standard_False);
+
+    IMeshTools_Parameters mp;
+    mp.Deflection = p.linearDeflection;
+    mp.Angle = DegToRad(p.angularDeflectionDeg);
+    mp.Relative = false;
+    mp.ControlSurfaceDeflection = p.curvatureAware;
+    {
+        // OCCT's pool runs at full width; the lease is released before the passes below
+        WorkerLease lease(p.parallel ? WorkerCount() - 1 : 0, LeaseMode::AllOrNothing);
+        mp.InParallel = lease.Count() > 0;
+        OperationProgress progress("Mesh");
+        BRepMesh_IncrementalMesh mesher(os, mp, progress.Range());  // meshes in the constructor
+        progress.ThrowIfCancelled();
+    }
+
+    // Pass 1: sizes per face; prefix offsets give every face a fixed slice of the output arrays
+    struct FaceSlice {
+        TopoDS_Face face;
+        Handle(Poly_Triangulation) tri;
+        TopLoc_Location loc;
+        bool reversed = false;
+        size_t node0 = 0;
+        size_t tri0 = 0;
+    };
+    std::vector<FaceSlice> faces;
+    size_t nbNodes = 0, nbTris = 0;
     for (TopExp_Explorer ex(os, TopAbs_FACE); ex.More(); ex.Next()) {
         const TopoDS_Face face = TopoDS::Face(ex.Current());
-        TopLoc_Location loc;
-        Handle(Poly_Triangulation) tri = BRep_Tool::Triangulation(face, loc);
-        if (tri.IsNull()) continue;
-
-        const gp_Trsf trsf = loc.Transformation();
-        const bool reversed = (face.Orientation() == TopAbs_REVERSED);
+        FaceSlice f;
+        f.face = face;
+        f.tri = BRep_Tool::Triangulation(face, f.loc);
+        if (f.tri.IsNull()) continue;
+        f.reversed = (face.Orientation() == TopAbs_REVERSED);
+        f.node0 = nbNodes;
+        f.tri0 = nbTris;
+        nbNodes += static_cast<size_t>(f.tri->NbNodes());
+        nbTris += static_cast<size_t>(f.tri->NbTriangles());
+        faces.push_back(std::move(f));
+    }
 
-        const int base = static_cast<int>(out.positions.size());
+    const size_t grain = p.parallel ? 8 : std::max<size_t>(faces.size(), 1);
 
-        // collect nodes
-        const int nbNodes = tri->NbNodes();
-        out.positions.reserve(out.positions.size() + static_cast<size_t>(nbNodes));
-        for (int i = 1; i <= nbNodes; ++i) {
-            gp_Pnt p = tri->Node(i).Transformed(trsf);
-            out.positions.emplace_back(Vec3(p.X(), p.Y(), p.Z()));
+    // Surface normals live on the triangulation, which located instances of a face share: compute each once
+    std::vector<const FaceSlice*> unique;
+    {
+        std::unordered_set<const Poly_Triangulation*> seen;
+        for (const auto& f : faces) {
+            if (!f.tri->HasNormals() && seen.insert(f.tri.get()).second) unique.push_back(&f);
+        }
+    }
+    ParallelFor(0, unique.size(), grain, [&unique](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            BRepLib_ToolTriangulatedShape::ComputeNormals(unique[i]->face, unique[i]->tri);
         }
+    });
+
+    TriMesh out;
+    out.positions.resize(nbNodes);
+    out.normals.resize(nbNodes);
+    out.indices.resize(nbTris * 3);
+
+    // Pass 2: faces write disjoint slices, so the result does not depend on the thread count
+    ParallelFor(0, faces.size(), grain, [&faces, &out](size_t begin, size_t end) {
+        for (size_t fi = begin; fi < end; ++fi) {
+            const FaceSlice& f = faces[fi];
+            const bool identity = f.loc.IsIdentity();
+            const gp_Trsf trsf = f.loc.Transformation();
 
-        // collect triangles
-        const int nbTris = tri->NbTriangles();
-        totalNumTriangles += nbTris;
-        out.indices.reserve(out.indices.size() + static_cast<size_t>(nbTris) * 3);
-        for (int i = 1; i <= nbTris; ++i) {
-            const Poly_Triangle t = tri->Triangle(i);
-            int n1, n2, n3;
-            t.Get(n1, n2, n3);  // 1-basiert
-
-            unsigned i1 = base + (n1 - 1);
-            unsigned i2 = base + (n2 - 1);
-            unsigned i3 = base + (n3 - 1);
-            if (reversed) std::swap(i2, i3);
-
-            out.indices.push_back(i1);
-            out.indices.push_back(i2);
-            out.indices.push_back(i3);
+            const int n = f.tri->NbNodes();
+            Vec3* dst = out.positions.data() + f.node0;
+            Vec3* nrm = out.normals.data() + f.node0;
+            const bool hasNormals = f.tri->HasNormals();
+            for (int i = 1; i <= n; ++i) {
+                gp_XYZ xyz = f.tri->Node(i).XYZ();
+                if (!identity) trsf.Transforms(xyz);
+                dst[i - 1] = Vec3(xyz.X(), xyz.Y(), xyz.Z());
+
+                if (!hasNormals) continue;
+                gp_Vec nv(f.tri->Normal(i));
+                if (!identity) nv.Transform(trsf);
+                if (f.reversed) nv.Reverse();
+                nrm[i - 1] = Vec3(nv.X(), nv.Y(), nv.Z());
+            }
+
+            const int t = f.tri->NbTriangles();
+            const unsigned base = static_cast<unsigned>(f.node0);
+            unsigned* idx = out.indices.data() + f.tri0 * 3;
+            for (int i = 1; i <= t; ++i) {
+                int n1, n2, n3;
+                f.tri->Triangle(i).Get(n1, n2, n3);  // 1-based
+                if (f.reversed) std::swap(n2, n3);
+                *idx++ = base + static_cast<unsigned>(n1 - 1);
+                *idx++ = base + static_cast<unsigned>(n2 - 1);
+                *idx++ = base + static_cast<unsigned>(n3 - 1);
+            }
         }
-    }
-    LOG(INFO) << "Triangulation::NumTriangles: " << totalNumTriangles;
+    });
+    LOG(INFO) << "Triangulation::NumTriangles: " << nbTris;
 
+    if (p.weld) WeldVertices(out, p.creaseAngleDeg);
     return out;
 }
 
+TriangulationParams QualityPreset(MeshQuality q) {
+    TriangulationParams p;
+    switch (q) {
+        case MeshQuality::Draft:
+            p.relativeDeflection = 2e-3;
+            p.minDeflection = 0.05;
+            p.maxDeflection = 5.0;
+            p.angularDeflectionDeg = 30.0;
+            p.curvatureAware = false;
+            break;
+        case MeshQuality::Normal:
+            p.relativeDeflection = 5e-4;
+            p.minDeflection = 0.01;
+            p.maxDeflection = 1.0;
+            p.angularDeflectionDeg = 20.0;
+            break;
+        case MeshQuality::Fine:
+            p.relativeDeflection = 1e-4;
+            p.minDeflection = 0.005;
+            p.maxDeflection = 0.25;
+            p.angularDeflectionDeg = 10.0;
+            break;
+        case MeshQuality::Legacy:
+            p.linearDeflection = 0.1;
+            p.angularDeflectionDeg = 25.0;
+            break;
+    }
+    return p;
+}
+
+bool ParseMeshQuality(const std::string& name, MeshQuality& out) {
+    if (name == "draft") {
+        out = MeshQuality::Draft;
+    } else if (name == "normal") {
+        out = MeshQuality::Normal;
+    } else if (name == "fine") {
+        out = MeshQuality::Fine;
+    } else if (name == "legacy") {
+        out = MeshQuality::Legacy;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static TriangulationParams ResolveParams(const TopoDS_Shape& os, const TriangulationParams& p) {
+    TriangulationParams r = p;
+    if (p.relativeDeflection <= 0.0) return r;
+
+    Bnd_Box box;
+    BRepBndLib::Add(os, box);
+    const double diag = box.IsVoid() ? 0.0 : std::sqrt(box.SquareExtent());
+    r.linearDeflection = std::clamp(p.relativeDeflection * diag, p.minDeflection, p.maxDeflection);
+    r.relativeDeflection = 0.0;
+    return r;
+}
+
+TriangulationParams ResolveParams(const Shape& shape, const TriangulationParams& p) {
+    auto s = ShapeAsOcct(shape);
+    if (!s) throw std::runtime_error("Triangulate: non-OCCT shape implementation");
+    return ResolveParams(s->Occt(), p);
+}
+
+std::shared_ptr<const TriMesh> TriangulateShared(const Shape& shape, const geom::TriangulationParams& params) {
+    auto s = ShapeAsOcct(shape);
+    if (!s) throw std::runtime_error("Triangulate: non-OCCT shape implementation");
+
+    // Cache on the resolved parameters: equal shapes at equal size share one entry
+    const TopoDS_Shape& os = s->Occt();
+    const auto p = ResolveParams(os, params);
+    return MeshCache::Instance().GetOrCreate(os, p, [&os, &p]() { return MeshShape(os, p); });
+}
+
+TriMesh Triangulate(const Shape& shape, const geom::TriangulationParams& p) {
+    return *TriangulateShared(shape, p);
+}
+
+void ClearMeshCache() {
+    MeshCache::Instance().Clear();
+}
+
+void SetMeshCacheBudget(size_t bytes) {
+    MeshCache::Instance().SetBudget(bytes);
+}
+
 }  // namespace ccad::geom
@@ -1,14 +1,26 @@
 #include <gtest/gtest.h>
 
+#include <ccad/base/Exception.hpp>
+#include <ccad/base/OpCache.hpp>
+#include <ccad/base/Progress.hpp>
+#include <ccad/base/Stats.hpp>
 #include <ccad/draft/Section.hpp>
 #include <ccad/geom/Box.hpp>
+#include <ccad/geom/Cylinder.hpp>
 #include <ccad/geom/Sphere.hpp>
 #include <ccad/ops/Boolean.hpp>
+#include <ccad/ops/Pattern.hpp>
 #include <ccad/ops/Transform.hpp>
+#include <ccad/feature/Fillet.hpp>
+#include <ccad/feature/Shell.hpp>
+#include <ccad/select/EdgeSelector.hpp>
+#include <ccad/select/FaceSelector.hpp>
 #include <ccad/sketch/Rectangle.hpp>
+#include <thread>
 
 #include "ccad/base/Math.hpp"
 #include "ccad/construct/Extrude.hpp"
+#include "ccad/io/Brep.hpp"
 #include "ccad/io/Dxf.hpp"
 
 using namespace std;
@@ -27,6 +39,108 @@ TEST(TestOps, TestUnion) {
     EXPECT_NEAR(bbox.Size().x, 20, 1e-6);
 }
 
+TEST(TestOps, TestUnionMany) {
+    std::vector<Shape> boards;
+    for (int i = 0; i < 12; ++i) boards.push_back(ops::Translate(Box(10, 100, 2), i * 9, 0, 0));
+
+    auto fused = ops::Union(boards);
+    auto bbox = fused.BBox();
+    EXPECT_NEAR(bbox.Size().x, 11 * 9 + 10, 1e-6);
+    EXPECT_NEAR(bbox.Size().y, 100, 1e-6);
+}
+
+TEST(TestOps, TestDisjointFastPath) {
+    ClearOpCache();
+    auto body = Box(10, 10, 10);
+    auto far = ops::Translate(Box(5, 5, 5), 100, 0, 0);
+
+    auto before = GetKernelStats();
+    auto cut = ops::Difference(body, far);
+    EXPECT_NEAR(cut.BBox().Size().x, 10, 1e-6);
+
+    auto fused = ops::Union({body, far});
+    EXPECT_NEAR(fused.BBox().Size().x, 105, 1e-6);
+    auto after = GetKernelStats();
+
+    EXPECT_EQ(after.booleanFastPaths - before.booleanFastPaths, 2u);
+}
+
+TEST(TestOps, TestValidityMemo) {
+    auto body = ops::Translate(ops::Difference(Box(20, 20, 10), ops::Translate(Box(5, 5, 20), 5, 5, -5)), 1, 2, 3);
+
+    auto before = GetKernelStats();
+    auto rounded = feature::FilletAll(body, 0.5);
+    auto after = GetKernelStats();
+
+    // Primitive -> boolean -> move is known valid: the fillet does not run the analyzer
+    EXPECT_EQ(after.validityChecks - before.validityChecks, 0u);
+    EXPECT_GT(rounded.BBox().Size().x, 0);
+}
+
+TEST(TestOps, TestValidityOfPassThrough) {
+    ClearOpCache();
+    ASSERT_TRUE(io::SaveBREP(Box(5, 5, 5), "box_import.brep"));
+    auto imported = io::LoadBREP("box_import.brep");
+    ASSERT_TRUE(imported.has_value());
+
+    // Disjoint operands: the import is passed through unfused and keeps its unknown validity
+    auto both = ops::Union({*imported, ops::Translate(Box(5, 5, 5), 50, 0, 0)});
+    auto before = GetKernelStats();
+    feature::FilletAll(both, 0.5);
+    auto after = GetKernelStats();
+    EXPECT_GT(after.validityChecks - before.validityChecks, 0u);
+}
+
+TEST(TestOps, TestOpCache) {
+    ClearOpCache();
+    auto build = [](double hole) {
+        return ops::Difference(Box(20, 20, 10), ops::Translate(Cylinder(hole, 20), 10, 10, -5));
+    };
+
+    auto first = build(5);
+    auto before = GetKernelStats();
+    auto again = build(5);
+    auto after = GetKernelStats();
+    EXPECT_TRUE(again.SharesWith(first));
+    EXPECT_EQ(after.opCacheMisses - before.opCacheMisses, 0u);
+    EXPECT_EQ(after.opCacheHits - before.opCacheHits, 3u);  // box, cylinder, difference
+
+    // A new hole diameter recomputes only the cylinder and the difference
+    auto wider = build(6);
+    auto last = GetKernelStats();
+    EXPECT_EQ(last.opCacheMisses - after.opCacheMisses, 2u);
+    EXPECT_EQ(last.opCacheHits - after.opCacheHits, 1u);
+    EXPECT_FALSE(wider.SharesWith(first));
+
+    // Hits on another thread count globally but not for this thread
+    const auto mine = GetThreadKernelStats();
+    std::thread([&] { build(5); }).join();
+    EXPECT_EQ(GetThreadKernelStats().opCacheHits, mine.opCacheHits);
+    EXPECT_EQ(GetKernelStats().opCacheHits - last.opCacheHits, 3u);
+}
+
+TEST(TestOps, TestCancellation) {
+    ClearOpCache();
+    auto b1 = Box(10, 10, 10);
+    auto b2 = ops::Translate(Box(10, 10, 10), 5, 0, 0);
+
+    CancelToken token;
+    std::vector<double> fractions;
+    {
+        OperationContext context(token, [&](const char*, double f) { fractions.push_back(f); });
+        EXPECT_GT(ops::Union({b1, b2}).BBox().Size().x, 0);
+        token.Cancel();
+        try {
+            ops::Difference(b1, b2);
+            FAIL() << "cancelled operation did not throw";
+        } catch (const Exception& e) {
+            EXPECT_EQ(e.getStatus(), Status::CANCELLED);
+        }
+    }
+    EXPECT_FALSE(IsCancelled());  // outside the context nothing is cancelled
+    for (double f : fractions) EXPECT_LE(f, 1.0);
+}
+
 TEST(TestOps, TestDifference) {
     auto b1 = Box(10, 10, 10);
     auto b2 = Box(5, 10, 10);
@@ -40,6 +154,132 @@ TEST(TestOps, TestDifference) {
     EXPECT_NEAR(bbox.min.x, 5, 1e-6);
 }
 
+TEST(TestOps, TestDifferenceMany) {
+    auto plate = Box(100, 10, 10);
+    std::vector<Shape> tools;
+    for (int i = 0; i < 5; ++i) tools.push_back(ops::Translate(Box(5, 20, 20), i * 20 + 5, -5, -5));
+    tools.push_back(ops::Translate(Box(5, 5, 5), 500, 0, 0));  // misses the plate
+
+    auto cut = ops::Difference(plate, tools);
+    auto bbox = cut.BBox();
+    EXPECT_NEAR(bbox.Size().x, 100, 1e-6);
+    EXPECT_NEAR(bbox.Size().z, 10, 1e-6);
+}
+
+TEST(TestOps, TestApplyTransform) {
+    auto b = Box(10, 20, 30);
+
+    ops::Transform t;
+    t.rotateDeg = Vec3(0, 0, 90);
+    t.translate = Vec3(100, 0, 0);
+    auto placed = ops::Apply(b, t);
+
+    // Same result as chaining the single transforms
+    auto chained = ops::Translate(ops::RotateZ(b, 90), 100, 0, 0);
+    auto bb1 = placed.BBox(), bb2 = chained.BBox();
+    EXPECT_NEAR(bb1.min.x, bb2.min.x, 1e-6);
+    EXPECT_NEAR(bb1.Size().x, 20, 1e-6);
+    EXPECT_NEAR(bb1.Size().y, 10, 1e-6);
+
+    t.scale = 2.0;
+    EXPECT_NEAR(ops::Apply(b, t).BBox().Size().z, 60, 1e-6);
+}
+
+TEST(TestOps, TestPatterns) {
+    auto b = Box(10, 10, 10);
+
+    auto grid = ops::GridPattern(b, 3, 20, 2, 20);
+    EXPECT_NEAR(grid.BBox().Size().x, 50, 1e-6);
+    EXPECT_NEAR(grid.BBox().Size().y, 30, 1e-6);
+
+    auto row = ops::LinearPattern(b, 4, Vec3(10, 0, 0), /*fuse*/ true);
+    EXPECT_NEAR(row.BBox().Size().x, 40, 1e-6);
+
+    auto ring = ops::PolarPattern(b, 4, 50);
+    EXPECT_NEAR(ring.BBox().Size().z, 10, 1e-6);
+    EXPECT_NEAR(ring.BBox().max.x, 60, 1e-6);
+
+    Plane3 yz;
+    yz.normal = Vec3(1, 0, 0);
+    auto mirrored = ops::Mirror(b, yz);
+    EXPECT_NEAR(mirrored.BBox().min.x, -10, 1e-6);
+
+    Plane3 degenerate;
+    degenerate.normal = Vec3(0, 0, 0);
+    EXPECT_THROW(ops::Mirror(b, degenerate), std::invalid_argument);
+}
+
+TEST(TestOps, TestEdgeSelector) {
+    auto box = Box(10, 10, 10);
+
+    auto all = select::EdgeSelector::FromShape(box).collect();
+    EXPECT_EQ(all.size(), 12u);
+
+    // top edges: only sample points and bounds are computed
+    auto top = select::EdgeSelector::FromShape(box).onBoxSide(select::BoxSide::ZMax).collect();
+    EXPECT_EQ(top.size(), 4u);
+    for (const auto& e : top.items()) EXPECT_NEAR(e.length, 10.0, 1e-6);  // computed when materialized
+
+    auto vertical = select::EdgeSelector::FromShape(box)
+                        .geom(select::EdgeGeom::Line)
+                        .parallelTo(Axis::Z)
+                        .lengthBetween({9.9, 10.1})
+                        .collect();
+    EXPECT_EQ(vertical.size(), 4u);
+
+    // set algebra on bitsets: top edges parallel to X = top minus those parallel to Y
+    auto alongY = select::EdgeSelector::FromShape(box).parallelTo(Axis::Y).collect();
+    auto topX = top;
+    topX.subtract(alongY);
+    EXPECT_EQ(topX.size(), 2u);
+    topX.unite(vertical);
+    EXPECT_EQ(topX.size(), 6u);
+    topX.intersect(vertical);
+    EXPECT_EQ(topX.indices(), vertical.indices());
+
+    // BVH-backed region queries
+    auto corner = select::EdgeSelector::FromShape(box).nearPoint({0, 0, 0}, 0.1).collect();
+    EXPECT_EQ(corner.size(), 3u);
+    auto inside = select::EdgeSelector::FromShape(box).insideAABB({-1, -1, -1}, {11, 11, 1}).collect();
+    EXPECT_EQ(inside.size(), 4u);
+
+    // Same edge count, different shape: combining the sets must fail
+    auto other = select::EdgeSelector::FromShape(Box(20, 10, 10)).collect();
+    EXPECT_THROW(topX.unite(other), std::runtime_error);
+}
+
+TEST(TestOps, TestFaceSelector) {
+    auto box = Box(20, 10, 5);
+
+    auto planes = select::FaceSelector::FromShape(box).geom(select::FaceGeom::Plane).collect();
+    EXPECT_EQ(planes.size(), 6u);
+
+    auto top = select::FaceSelector::FromShape(box).onBoxSide(select::BoxSide::ZMax).collect();
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_NEAR(top.items()[0].area, 200.0, 1e-6);
+
+    auto largest = select::FaceSelector::FromShape(box).normalParallelTo(Axis::Z).largest(1).collect();
+    EXPECT_EQ(largest.size(), 1u);
+
+    auto sides = select::FaceSelector::FromShape(box).adjacentTo(top).collect();
+    EXPECT_EQ(sides.size(), 4u);
+
+    auto pierced = select::FaceSelector::FromShape(box).hitByRay({5, 5, 100}, {0, 0, -1}).collect();
+    EXPECT_EQ(pierced.size(), 2u);
+    auto first = select::FaceSelector::FromShape(box).hitByRay({5, 5, 100}, {0, 0, -1}, true).collect();
+    EXPECT_EQ(first.indices(), top.indices());
+    // a short direction vector must not change which face is nearest
+    auto firstShort = select::FaceSelector::FromShape(box).hitByRay({5, 5, 100}, {0, 0, -0.01f}, true).collect();
+    EXPECT_EQ(firstShort.indices(), top.indices());
+    EXPECT_THROW(select::FaceSelector::FromShape(box).hitByRay({5, 5, 100}, {0, 0, 0}), std::invalid_argument);
+
+    auto cup = feature::Shell(box, top, 1.0);
+    auto bbox = cup.BBox();
+    EXPECT_NEAR(bbox.Size().x, 20, 1e-3);
+    EXPECT_NEAR(bbox.Size().z, 5, 1e-3);
+    EXPECT_EQ(select::FaceSelector::FromShape(cup).collect().size(), 11u);  // 5 outer, 5 inner, rim
+}
+
 TEST(TestOps, TestExtrude) {
     auto rect = Rectangle(5, 10);
     auto box = construct::ExtrudeZ(rect, 10);
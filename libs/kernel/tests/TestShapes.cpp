@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <ccad/base/Measure.hpp>
 #include <ccad/geom/Box.hpp>
 #include <ccad/geom/Cylinder.hpp>
 
@@ -25,3 +26,35 @@ TEST(TestShapes, Shape_Create) {
     // auto bbRes = kernel->bbox(box, /*triangulated=*/false);
     // ASSERT_TRUE(bbRes.has_value()) << "bbox failed: " << bbRes.message();
 }
+
+TEST(TestShapes, Shape_CopyOnWrite) {
+    auto box = Box(10, 10, 10);
+    Shape copy = box;
+    EXPECT_TRUE(copy.SharesWith(box));
+
+    copy.Detach();
+    EXPECT_FALSE(copy.SharesWith(box));
+    EXPECT_NEAR(copy.BBox().Size().x, 10, 1e-6);
+
+    Shape empty;
+    EXPECT_FALSE(empty);
+}
+
+TEST(TestShapes, Shape_CachedMeasures) {
+    auto box = Box(10, 10, 10);
+    auto mass = MassProperties(box);
+    EXPECT_NEAR(mass.volume, 1000, 1e-6);
+    EXPECT_NEAR(mass.area, 600, 1e-6);
+    EXPECT_NEAR(mass.centroid.z, 5, 1e-6);
+
+    auto counts = CountTopology(box);
+    EXPECT_EQ(counts.solids, 1);
+    EXPECT_EQ(counts.faces, 6);
+    EXPECT_EQ(counts.edges, 12);
+    EXPECT_EQ(counts.vertices, 8);
+    EXPECT_TRUE(IsValidShape(box));
+
+    // Copies share the cached values
+    Shape copy = box;
+    EXPECT_NEAR(MassProperties(copy).volume, 1000, 1e-6);
+}
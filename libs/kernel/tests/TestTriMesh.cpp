@@ -1,9 +1,21 @@
 #include <gtest/gtest.h>
 
+#include <ccad/base/Execution.hpp>
+#include <ccad/base/Stats.hpp>
 #include <ccad/geom/Box.hpp>
+#include <ccad/geom/Cylinder.hpp>
+#include <ccad/geom/Sphere.hpp>
+#include <ccad/ops/Boolean.hpp>
+#include <ccad/ops/Transform.hpp>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <thread>
 
 #include "ccad/geom/Triangulation.hpp"
 #include "ccad/io/Export.hpp"
+#include "internal/Execution.hpp"
 
 using namespace ccad;
 using namespace ccad::geom;
@@ -16,3 +28,154 @@ TEST(TestTriMesh, CreateMesh) {
     io::SaveSTL(box, "box.stl", params);
     // std::cout << mesh;
 }
+
+TEST(TestTriMesh, MeshCacheHit) {
+    auto box = Box(2, 2, 2);
+
+    TriangulationParams params;
+    auto before = GetKernelStats();
+    auto first = TriangulateShared(box, params);
+    auto second = TriangulateShared(box, params);
+    io::SaveSTL(box, "box_cached.stl", params);
+    auto after = GetKernelStats();
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(after.meshCacheMisses - before.meshCacheMisses, 1u);
+    EXPECT_EQ(after.meshCacheHits - before.meshCacheHits, 2u);
+
+    // Different deflection is a different cache entry
+    params.linearDeflection *= 0.5;
+    auto finer = TriangulateShared(box, params);
+    EXPECT_NE(first.get(), finer.get());
+}
+
+TEST(TestTriMesh, WriteBinarySTL) {
+    auto box = Box(1, 1, 1);
+    auto mesh = Triangulate(box, TriangulationParams{});
+    const size_t triCount = mesh.indices.size() / 3;
+    ASSERT_GT(triCount, 0u);
+
+    ASSERT_TRUE(io::WriteSTL(mesh, "box_binary.stl"));
+    EXPECT_EQ(std::filesystem::file_size("box_binary.stl"), 84u + 50u * triCount);
+
+    io::StlOptions opt;
+    opt.format = io::StlFormat::Ascii;
+    ASSERT_TRUE(io::WriteSTL(mesh, "box_ascii.stl", opt));
+    EXPECT_GT(std::filesystem::file_size("box_ascii.stl"), 84u + 50u * triCount);
+}
+
+TEST(TestTriMesh, RelativeDeflection) {
+    auto small = Box(5, 5, 5);
+    auto large = Box(4000, 1000, 100);
+
+    auto p = QualityPreset(MeshQuality::Normal);
+    auto rs = ResolveParams(small, p);
+    auto rl = ResolveParams(large, p);
+
+    EXPECT_DOUBLE_EQ(rs.linearDeflection, p.minDeflection);
+    EXPECT_DOUBLE_EQ(rl.linearDeflection, p.maxDeflection);
+    EXPECT_EQ(rl.relativeDeflection, 0.0);
+
+    MeshQuality q;
+    EXPECT_TRUE(ParseMeshQuality("draft", q));
+    EXPECT_EQ(q, MeshQuality::Draft);
+    EXPECT_FALSE(ParseMeshQuality("ultra", q));
+}
+
+TEST(TestTriMesh, NormalsAndWelding) {
+    auto box = Box(10, 10, 10);
+
+    TriangulationParams params;
+    auto mesh = Triangulate(box, params);
+    ASSERT_EQ(mesh.normals.size(), mesh.positions.size());
+    for (const auto& n : mesh.normals) {
+        EXPECT_NEAR(n.x * n.x + n.y * n.y + n.z * n.z, 1.0, 1e-6);
+    }
+
+    // Box edges are 90° creases: welding must keep one vertex per face at each corner
+    params.weld = true;
+    auto welded = Triangulate(box, params);
+    EXPECT_EQ(welded.positions.size(), mesh.positions.size());
+
+    // Without a crease limit the 8 corners collapse to one vertex each
+    params.creaseAngleDeg = 180.0;
+    auto smooth = Triangulate(box, params);
+    EXPECT_EQ(smooth.positions.size(), 8u);
+    EXPECT_EQ(smooth.indices.size(), mesh.indices.size());
+}
+
+TEST(TestTriMesh, ParallelMeshIsDeterministic) {
+    auto part = ops::Difference(Box(20, 20, 10), ops::Translate(Cylinder(5, 20), 10, 10, -5));
+    const size_t initial = WorkerCount();
+    SetWorkerCount(4);
+
+    TriangulationParams params;
+    params.parallel = false;
+    ClearMeshCache();
+    const auto serial = Triangulate(part, params);
+    ClearMeshCache();  // `parallel` is not part of the cache key either
+    params.parallel = true;
+    const auto parallel = Triangulate(part, params);
+    SetWorkerCount(initial);
+
+    auto same = [](const std::vector<Vec3>& a, const std::vector<Vec3>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].x != b[i].x || a[i].y != b[i].y || a[i].z != b[i].z) return false;
+        }
+        return true;
+    };
+    ASSERT_FALSE(serial.indices.empty());
+    EXPECT_TRUE(same(serial.positions, parallel.positions));
+    EXPECT_TRUE(same(serial.normals, parallel.normals));
+    EXPECT_EQ(serial.indices, parallel.indices);
+}
+
+TEST(TestTriMesh, WorkerBudget) {
+    auto mesh = Triangulate(Sphere(20), TriangulationParams{});
+    io::StlOptions opt;
+    opt.chunkTriangles = 16;  // many chunks, formatted by the leased workers
+
+    const size_t initial = WorkerCount();
+    SetWorkerCount(1);
+    EXPECT_EQ(WorkerCount(), 1u);
+    ASSERT_TRUE(io::WriteSTL(mesh, "sphere_serial.stl", opt));
+
+    SetWorkerCount(4);
+    ASSERT_TRUE(io::WriteSTL(mesh, "sphere_parallel.stl", opt));
+    {
+        WorkerScope scope;  // nested inside a scheduled job the export must still succeed
+        ASSERT_TRUE(io::WriteSTL(mesh, "sphere_nested.stl", opt));
+    }
+    SetWorkerCount(initial);
+
+    auto read = [](const char* path) {
+        std::ifstream f(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(f), {});
+    };
+    EXPECT_EQ(read("sphere_serial.stl"), read("sphere_parallel.stl"));
+    EXPECT_EQ(read("sphere_serial.stl"), read("sphere_nested.stl"));
+}
+
+TEST(TestTriMesh, WorkerLeaseInFullBudget) {
+    const size_t initial = WorkerCount();
+    SetWorkerCount(2);
+    {
+        WorkerScope scope;
+        std::promise<void> entered, release;
+        std::thread job([&]() {
+            WorkerScope busy;  // a second scheduled job: both workers are taken
+            entered.set_value();
+            release.get_future().wait();
+        });
+        entered.get_future().wait();
+        EXPECT_EQ(WorkerLease(WorkerCount()).Count(), 0u);
+        EXPECT_EQ(WorkerLease(WorkerCount() - 1, LeaseMode::AllOrNothing).Count(), 0u);
+        release.set_value();
+        job.join();
+
+        // The other job is done, an OCCT algorithm may take the whole pool again
+        EXPECT_EQ(WorkerLease(WorkerCount() - 1, LeaseMode::AllOrNothing).Count(), 1u);
+    }
+    SetWorkerCount(initial);
+}
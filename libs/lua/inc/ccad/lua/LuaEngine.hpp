@@ -1,18 +1,18 @@
 #pragma once
 #include <ccad/base/Shape.hpp>
 #include <ccad/geom/Triangulation.hpp>
+#include <ccad/select/EdgeSelector.hpp>
 #include <sol/sol.hpp>
 #include <string>
+#include <vector>
 
 namespace ccad {
 namespace lua {
 
-static inline geom::TriangulationParams GetTriangulationParameters() {
-    geom::TriangulationParams params;
-    params.angularDeflectionDeg = 25.0;
-    params.linearDeflection = 0.1;
-    params.parallel = true;
-    return params;
+/// Default tessellation: deflection relative to the part size (see geom::MeshQuality).
+static inline geom::TriangulationParams GetTriangulationParameters(
+    geom::MeshQuality quality = geom::MeshQuality::Normal) {
+    return geom::QualityPreset(quality);
 }
 
 /**
@@ -37,11 +37,12 @@ class LuaEngine {
     /// Returns false on failure and fills errorMsg.
     bool Initialize(std::string* errorMsg = nullptr);
 
-    /// Execute a Lua script file (path). Initialize() must be called first.
-    /// Returns false on error.
+    /// Execute a Lua script file (path) and clear the shape emitted by earlier runs. Initialize() must be called first.
+    /// Each file starts from the globals as of Initialize(); modules required by the previous run are loaded afresh.
+    /// Returns false on error, or if the thread's ccad::OperationContext was cancelled during the run.
     bool RunFile(const std::string& scriptPath);
 
-    /// Execute a Lua script. Initialize() must be called first.
+    /// Execute a Lua script. Initialize() must be called first. Globals set by earlier runs stay visible.
     /// Returns false on error.
     bool RunString(const std::string& script);
 
@@ -51,12 +52,25 @@ class LuaEngine {
     /// Access emitted shape (if any) as produced by Lua 'emit(...)'.
     std::optional<Shape> GetEmitted() const;
 
+    /// Modules `require`d by the last run, transitively and sorted (also those already loaded before).
+    std::vector<std::string> RequiredModules();
+
+    /// Files of RequiredModules() resolved through package.path; modules without a Lua file are skipped.
+    std::vector<std::string> RequiredModuleFiles();
+
     /// Set the emitted shape
     void SetEmitted(const Shape& s);
 
     /// Triangulate the emitted shape for real-time viewing. Throws if no shape.
     geom::TriMesh TriangulateEmitted() const;
 
+    /// Tessellation used by TriangulateEmitted() and the Lua `save_stl`.
+    void SetTriangulationParameters(const geom::TriangulationParams& p);
+    const geom::TriangulationParams& TriangulationParameters() const;
+
+    /// Edge selectors of the current script run; repeated `edges(s)` on one shape share an index.
+    select::EdgeSelectorCache& EdgeSelectors();
+
     /// Direct access to the Lua state if advanced users need it.
     sol::state& Lua();
 
@@ -64,10 +78,19 @@ class LuaEngine {
     /// Build the package.path prefix string from m_LibraryPaths.
     std::string BuildPackagePathPrefix() const;
 
+    /// Start a run from a clean state: drop the previous run's modules from package.loaded, so a reused engine
+    /// re-reads edited library files, and optionally restore the globals as they were after Initialize().
+    void BeginRun(bool resetGlobals);
+
+    /// Print a failed run's error, unless the run was cancelled.
+    void ReportError(sol::protected_function_result& result);
+
    private:
     sol::state m_Lua;
     std::vector<std::string> m_LibraryPaths;
     Shape m_Emitted;
+    geom::TriangulationParams m_MeshParams{GetTriangulationParameters()};
+    select::EdgeSelectorCache m_EdgeSelectors;
 
     bool m_Initialized{false};
 };
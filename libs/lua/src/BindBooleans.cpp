@@ -9,12 +9,20 @@ namespace ccad {
 namespace lua {
 
 void RegisterBooleans(sol::state& lua) {
+    // union(a, b, ...) or union({a, b, ...})
     lua.set_function("union", [](sol::variadic_args va) -> Shape {
         std::vector<Shape> shapes;
         shapes.reserve(va.size());
         for (auto v : va) {
             if (v.is<Shape>()) {
                 shapes.push_back(v.as<Shape>());
+            } else if (v.get_type() == sol::type::table) {
+                sol::table t = v;
+                for (size_t i = 1; i <= t.size(); ++i) {
+                    sol::object o = t[i];
+                    if (!o.is<Shape>()) throw std::runtime_error("union({...}) expects a list of shapes");
+                    shapes.push_back(o.as<Shape>());
+                }
             } else {
                 throw std::runtime_error("union(...) expects shapes");
             }
@@ -25,7 +33,20 @@ void RegisterBooleans(sol::state& lua) {
         return Union(shapes);
     });
 
-    lua.set_function("difference", [](const Shape& a, const Shape& b) -> Shape { return Difference(a, b); });
+    // difference(a, b) or difference(body, {tool1, tool2, ...})
+    auto differenceMany = [](const Shape& a, sol::table tools) -> Shape {
+        std::vector<Shape> list;
+        list.reserve(tools.size());
+        for (size_t i = 1; i <= tools.size(); ++i) {
+            sol::object o = tools[i];
+            if (!o.is<Shape>()) throw std::runtime_error("difference(body, {...}) expects a list of shapes");
+            list.push_back(o.as<Shape>());
+        }
+        return Difference(a, list);
+    };
+    lua.set_function("difference",
+                     sol::overload([](const Shape& a, const Shape& b) -> Shape { return Difference(a, b); },
+                                   differenceMany));
 
     lua.set_function("intersection", [](const Shape& a, const Shape& b) -> Shape { return Intersection(a, b); });
 }
@@ -2,6 +2,7 @@
 #include <ccad/base/Shape.hpp>
 #include <ccad/feature/Chamfer.hpp>
 #include <ccad/feature/Fillet.hpp>
+#include <ccad/feature/Shell.hpp>
 #include <sol/sol.hpp>
 
 #include "ccad/lua/Bindings.hpp"
@@ -36,6 +37,20 @@ void RegisterFeatures(sol::state& lua) {
     lua.set_function("chamfer", [](const Shape& s, const EdgeSet& es, double distance_mm) {
         return feature::Chamfer(s, es, distance_mm);
     });
+
+    // Hollow a solid; the selected faces become openings (nil = closed cavity)
+    lua.set_function("shell", [](const Shape& s, sol::object open, double thickness_mm) -> Shape {
+        FaceSet faces;
+        if (open.is<FaceSet>())
+            faces = open.as<FaceSet>();
+        else if (open.valid())  // anything but nil
+            throw std::runtime_error("shell: open faces must be a FaceSet or nil");
+        try {
+            return feature::Shell(s, faces, thickness_mm);
+        } catch (const Exception& e) {
+            throw std::runtime_error(std::string("shell failed: ") + e.getDescription());
+        }
+    });
 }
 }  // namespace lua
 }  // namespace ccad
@@ -11,8 +11,10 @@ void RegisterIO(sol::state& lua, LuaEngine* owner) {
         owner->SetEmitted(s);
         return 0;
     });
-    lua.set_function("save_stl", [](const Shape& s, const std::string& path) {
-        io::SaveSTL(s, path, GetTriangulationParameters());
+    lua.set_function("save_stl", [owner](const Shape& s, const std::string& path, sol::optional<sol::table> opts) {
+        io::StlOptions opt;
+        if (opts && opts->get_or("ascii", false)) opt.format = io::StlFormat::Ascii;
+        io::SaveSTL(s, path, owner->TriangulationParameters(), opt);
     });
     lua.set_function("save_step", [](const Shape& s, const std::string& path) { io::SaveSTEP(s, path); });
 }
@@ -1,4 +1,5 @@
 #include <ccad/base/Math.hpp>
+#include <ccad/base/Measure.hpp>
 #include <ccad/base/Shape.hpp>
 #include <ccad/ops/Transform.hpp>
 #include <sol/sol.hpp>
@@ -43,6 +44,29 @@ void RegisterMeasure(sol::state& lua) {
         return BBoxToTable(lua, b);
     });
 
+    // Mass properties, validity and topology are cached on the shape
+    lua.set_function("volume", [](const Shape& s) { return MassProperties(s).volume; });
+    lua.set_function("surface_area", [](const Shape& s) { return MassProperties(s).area; });
+    lua.set_function("centroid", [&lua](const Shape& s) {
+        const Vec3 c = MassProperties(s).centroid;
+        sol::table t = lua.create_table();
+        t["x"] = c.x;
+        t["y"] = c.y;
+        t["z"] = c.z;
+        return t;
+    });
+    lua.set_function("is_valid", [](const Shape& s) { return IsValidShape(s); });
+    lua.set_function("topology", [&lua](const Shape& s) {
+        const TopoCounts n = CountTopology(s);
+        sol::table t = lua.create_table();
+        t["solids"] = n.solids;
+        t["shells"] = n.shells;
+        t["faces"] = n.faces;
+        t["edges"] = n.edges;
+        t["vertices"] = n.vertices;
+        return t;
+    });
+
     // Center helpers
     lua.set_function("center_x", [](const Shape& s) {
         auto b = s.BBox();
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <ccad/base/Exception.hpp>
 #include <ccad/base/Shape.hpp>
+#include <ccad/lua/LuaEngine.hpp>
 #include <ccad/select/EdgeSelector.hpp>
+#include <ccad/select/FaceSelector.hpp>
 #include <optional>
 #include <sol/sol.hpp>
 
@@ -9,8 +12,28 @@ using namespace ccad::select;
 
 namespace {
 
+// "zmin", "zmax", "xmin", "xmax", "ymin", "ymax"
+BoxSide ParseBoxSide(const std::string& side) {
+    std::string k = side;
+    for (auto& c : k) c = (char)std::tolower(c);
+    if (k == "zmax") return BoxSide::ZMax;
+    if (k == "xmin") return BoxSide::XMin;
+    if (k == "xmax") return BoxSide::XMax;
+    if (k == "ymin") return BoxSide::YMin;
+    if (k == "ymax") return BoxSide::YMax;
+    return BoxSide::ZMin;
+}
+
+// "x" | "y" | "z"
+Axis ParseAxis(const std::string& axis) {
+    if (axis == "y" || axis == "Y") return Axis::Y;
+    if (axis == "z" || axis == "Z") return Axis::Z;
+    return Axis::X;
+}
+
 struct LuaEdgeQuery {
     std::optional<EdgeSelector> sel;
+    EdgeSelectorCache* cache = nullptr;  // owned by the engine; shares edge tables within a run
 
     EdgeSelector& S() {
         if (!sel) throw std::runtime_error("edges(): call :from(shape) first");
@@ -18,28 +41,14 @@ struct LuaEdgeQuery {
     }
 
     LuaEdgeQuery& from(const Shape& s) {
-        sel.emplace(EdgeSelector::FromShape(s));
+        sel.emplace(cache ? cache->FromShape(s) : EdgeSelector::FromShape(s));
         return *this;
     }
 
     // "zmin", "zmax", "xmin", "xmax", "ymin", "ymax"
-    LuaEdgeQuery& on_box_side(const std::string& side) {
-        std::string k = side;
-        for (auto& c : k) c = (char)std::tolower(c);
-        BoxSide bs = BoxSide::ZMin;
-        if (k == "zmin")
-            bs = BoxSide::ZMin;
-        else if (k == "zmax")
-            bs = BoxSide::ZMax;
-        else if (k == "xmin")
-            bs = BoxSide::XMin;
-        else if (k == "xmax")
-            bs = BoxSide::XMax;
-        else if (k == "ymin")
-            bs = BoxSide::YMin;
-        else if (k == "ymax")
-            bs = BoxSide::YMax;
-        S().onBoxSide(bs);
+    // optional tol in mm (default 1e-6, as for faces)
+    LuaEdgeQuery& on_box_side(const std::string& side, sol::optional<double> tol) {
+        S().onBoxSide(ParseBoxSide(side), tol.value_or(1e-6));
         return *this;
     }
 
@@ -56,15 +65,7 @@ struct LuaEdgeQuery {
 
     // axis: "x" | "y" | "z", optional tol in degrees (default 3°)
     LuaEdgeQuery& parallel(const std::string& axis, sol::optional<double> tol_deg) {
-        double tol = tol_deg.value_or(3.0);
-        Axis a = Axis::X;
-        if (axis == "x" || axis == "X")
-            a = Axis::X;
-        else if (axis == "y" || axis == "Y")
-            a = Axis::Y;
-        else if (axis == "z" || axis == "Z")
-            a = Axis::Z;
-        S().parallelTo(a, tol);
+        S().parallelTo(ParseAxis(axis), tol_deg.value_or(3.0));
         return *this;
     }
 
@@ -80,30 +81,189 @@ struct LuaEdgeQuery {
         return *this;
     }
 
+    // radius between [min,max] (mm), circular edges only
+    LuaEdgeQuery& radius_between(double min_mm, double max_mm) {
+        S().radiusBetween(RadiusRange({min_mm, max_mm}));
+        return *this;
+    }
+
+    // sample point within tol of the plane axis=value
+    LuaEdgeQuery& near_plane(const std::string& axis, double value, sol::optional<double> tol) {
+        S().nearPlane(ParseAxis(axis), value, tol.value_or(1e-3));
+        return *this;
+    }
+
+    // sample point inside the box [min,max]
+    LuaEdgeQuery& inside_box(double x0, double y0, double z0, double x1, double y1, double z1) {
+        S().insideAABB(glm::vec3(x0, y0, z0), glm::vec3(x1, y1, z1));
+        return *this;
+    }
+
+    // edges within radius of a point
+    LuaEdgeQuery& near_point(double x, double y, double z, double radius) {
+        S().nearPoint(glm::vec3(x, y, z), radius);
+        return *this;
+    }
+
     EdgeSet collect() {
         return S().collect();
     }
 };
 
+struct LuaFaceQuery {
+    std::optional<FaceSelector> sel;
+
+    FaceSelector& S() {
+        if (!sel) throw std::runtime_error("faces(): call :from(shape) first");
+        return *sel;
+    }
+
+    LuaFaceQuery& from(const Shape& s) {
+        sel.emplace(FaceSelector::FromShape(s));
+        return *this;
+    }
+
+    // "plane" | "cylinder" | "cone" | "sphere" | "torus" | "other"
+    LuaFaceQuery& geom(const std::string& kind) {
+        std::string k = kind;
+        for (auto& c : k) c = (char)std::tolower(c);
+        if (k == "plane")
+            S().geom(FaceGeom::Plane);
+        else if (k == "cylinder")
+            S().geom(FaceGeom::Cylinder);
+        else if (k == "cone")
+            S().geom(FaceGeom::Cone);
+        else if (k == "sphere")
+            S().geom(FaceGeom::Sphere);
+        else if (k == "torus")
+            S().geom(FaceGeom::Torus);
+        else if (k == "other")
+            S().geom(FaceGeom::Other);
+        else
+            throw std::runtime_error("faces():geom: unknown kind '" + kind + "'");
+        return *this;
+    }
+
+    // normal parallel to axis (either direction), optional tol in degrees (default 3°)
+    LuaFaceQuery& normal(const std::string& axis, sol::optional<double> tol_deg) {
+        S().normalParallelTo(ParseAxis(axis), tol_deg.value_or(3.0));
+        return *this;
+    }
+
+    LuaFaceQuery& on_box_side(const std::string& side, sol::optional<double> tol) {
+        S().onBoxSide(ParseBoxSide(side), tol.value_or(1e-6));
+        return *this;
+    }
+
+    // area between [min,max] (mm²)
+    LuaFaceQuery& area_between(double min_mm2, double max_mm2) {
+        S().areaBetween(AreaRange({min_mm2, max_mm2}));
+        return *this;
+    }
+
+    LuaFaceQuery& adjacent_to(const FaceSet& seeds) {
+        S().adjacentTo(seeds);
+        return *this;
+    }
+
+    LuaFaceQuery& largest(sol::optional<int> n) {
+        S().largest(static_cast<size_t>(std::max(1, n.value_or(1))));
+        return *this;
+    }
+
+    LuaFaceQuery& near_point(double x, double y, double z, double radius) {
+        S().nearPoint(glm::vec3(x, y, z), radius);
+        return *this;
+    }
+
+    // faces hit by the ray origin + t * dir; first = true keeps only the nearest
+    LuaFaceQuery& hit_by_ray(double ox, double oy, double oz, double dx, double dy, double dz,
+                             sol::optional<bool> first) {
+        S().hitByRay(glm::vec3(ox, oy, oz), glm::vec3(dx, dy, dz), first.value_or(false));
+        return *this;
+    }
+
+    FaceSet collect() {
+        return S().collect();
+    }
+};
+
 }  // namespace
 
 namespace ccad {
 namespace lua {
 
-void RegisterSelect(sol::state& lua) {
-    lua.new_usertype<EdgeSet>("EdgeSet", sol::no_constructor);
+void RegisterSelect(sol::state& lua, LuaEngine* owner) {
+    // set algebra returns new sets; the operands stay untouched
+    lua.new_usertype<EdgeSet>(
+        "EdgeSet", sol::no_constructor, "size", &EdgeSet::size, "unite",
+        [](const EdgeSet& a, const EdgeSet& b) {
+            EdgeSet r = a;
+            return r.unite(b);
+        },
+        "intersect",
+        [](const EdgeSet& a, const EdgeSet& b) {
+            EdgeSet r = a;
+            return r.intersect(b);
+        },
+        "subtract",
+        [](const EdgeSet& a, const EdgeSet& b) {
+            EdgeSet r = a;
+            return r.subtract(b);
+        });
 
     lua.new_usertype<LuaEdgeQuery>("EdgeQuery", sol::constructors<LuaEdgeQuery()>(), "from", &LuaEdgeQuery::from,
                                    "on_box_side", &LuaEdgeQuery::on_box_side, "geom", &LuaEdgeQuery::geom, "parallel",
                                    &LuaEdgeQuery::parallel, "dihedral_between", &LuaEdgeQuery::dihedral_between,
-                                   "length_between", &LuaEdgeQuery::length_between, "collect", &LuaEdgeQuery::collect);
+                                   "length_between", &LuaEdgeQuery::length_between, "radius_between",
+                                   &LuaEdgeQuery::radius_between, "near_plane", &LuaEdgeQuery::near_plane, "inside_box",
+                                   &LuaEdgeQuery::inside_box, "near_point", &LuaEdgeQuery::near_point, "collect",
+                                   &LuaEdgeQuery::collect);
 
-    lua.set_function("edges", sol::overload([]() { return LuaEdgeQuery{}; },
+    lua.new_usertype<FaceSet>(
+        "FaceSet", sol::no_constructor, "size", &FaceSet::size, "unite",
+        [](const FaceSet& a, const FaceSet& b) {
+            FaceSet r = a;
+            return r.unite(b);
+        },
+        "intersect",
+        [](const FaceSet& a, const FaceSet& b) {
+            FaceSet r = a;
+            return r.intersect(b);
+        },
+        "subtract",
+        [](const FaceSet& a, const FaceSet& b) {
+            FaceSet r = a;
+            return r.subtract(b);
+        });
+
+    lua.new_usertype<LuaFaceQuery>("FaceQuery", sol::constructors<LuaFaceQuery()>(), "from", &LuaFaceQuery::from,
+                                   "geom", &LuaFaceQuery::geom, "normal", &LuaFaceQuery::normal, "on_box_side",
+                                   &LuaFaceQuery::on_box_side, "area_between", &LuaFaceQuery::area_between,
+                                   "adjacent_to", &LuaFaceQuery::adjacent_to, "largest", &LuaFaceQuery::largest,
+                                   "near_point", &LuaFaceQuery::near_point, "hit_by_ray", &LuaFaceQuery::hit_by_ray,
+                                   "collect", &LuaFaceQuery::collect);
+
+    lua.set_function("faces", sol::overload([]() { return LuaFaceQuery{}; },
                                             [](const Shape& s) {
-                                                LuaEdgeQuery q;
+                                                LuaFaceQuery q;
                                                 q.from(s);
                                                 return q;
                                             }));
+
+    EdgeSelectorCache* cache = &owner->EdgeSelectors();
+    lua.set_function("edges", sol::overload(
+                                  [cache]() {
+                                      LuaEdgeQuery q;
+                                      q.cache = cache;
+                                      return q;
+                                  },
+                                  [cache](const Shape& s) {
+                                      LuaEdgeQuery q;
+                                      q.cache = cache;
+                                      q.from(s);
+                                      return q;
+                                  }));
 }
 }  // namespace lua
 }  // namespace ccad
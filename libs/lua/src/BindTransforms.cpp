@@ -1,3 +1,4 @@
+#include <ccad/ops/Pattern.hpp>
 #include <ccad/ops/Transform.hpp>
 #include <sol/sol.hpp>
 
@@ -15,6 +16,36 @@ void RegisterTransforms(sol::state& lua) {
     lua.set_function("rotate_y", [](const Shape& s, double deg) -> Shape { return RotateY(s, deg); });
     lua.set_function("rotate_z", [](const Shape& s, double deg) -> Shape { return RotateZ(s, deg); });
     lua.set_function("scale", [](const Shape& s, double factor) -> Shape { return ScaleUniform(s, factor); });
+
+    // transform(s, {x=, y=, z=, rx=, ry=, rz=, scale=, copy=})
+    lua.set_function("transform", [](const Shape& s, sol::table t) -> Shape {
+        Transform tr;
+        tr.translate = Vec3(t.get_or("x", 0.0), t.get_or("y", 0.0), t.get_or("z", 0.0));
+        tr.rotateDeg = Vec3(t.get_or("rx", 0.0), t.get_or("ry", 0.0), t.get_or("rz", 0.0));
+        tr.scale = t.get_or("scale", 1.0);
+        return Apply(s, tr, t.get_or("copy", false));
+    });
+
+    // Patterns: compounds of instances sharing one geometry; pass fuse=true for a single solid
+    lua.set_function("linear_pattern", [](const Shape& s, int n, double dx, double dy, double dz,
+                                          sol::optional<bool> fuse) -> Shape {
+        return LinearPattern(s, n, Vec3(dx, dy, dz), fuse.value_or(false));
+    });
+    lua.set_function("grid_pattern", [](const Shape& s, int nx, double dx, int ny, double dy,
+                                        sol::optional<bool> fuse) -> Shape {
+        return GridPattern(s, nx, dx, ny, dy, fuse.value_or(false));
+    });
+    lua.set_function("polar_pattern", [](const Shape& s, int n, double r, sol::optional<double> startDeg,
+                                         sol::optional<bool> orient, sol::optional<bool> fuse) -> Shape {
+        return PolarPattern(s, n, r, startDeg.value_or(0.0), orient.value_or(true), fuse.value_or(false));
+    });
+    lua.set_function("mirror", [](const Shape& s, double nx, double ny, double nz, sol::optional<double> px,
+                                  sol::optional<double> py, sol::optional<double> pz) -> Shape {
+        Plane3 plane;
+        plane.normal = Vec3(nx, ny, nz);
+        plane.point = Vec3(px.value_or(0.0), py.value_or(0.0), pz.value_or(0.0));
+        return Mirror(s, plane);
+    });
 }
 }  // namespace lua
 }  // namespace ccad
@@ -1,19 +1,48 @@
 #include "ccad/lua/LuaEngine.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <sstream>
 #include <filesystem>
 
 #include "ccad/base/Logger.hpp"
+#include "ccad/base/Progress.hpp"
+#include "ccad/base/Stats.hpp"
 #include "ccad/lua/Bindings.hpp"
 #include "ccad/lua/PrettyLuaError.hpp"
 
 namespace ccad::lua {
 
-LuaEngine::LuaEngine() : m_Emitted(nullptr) {
+namespace {
+
+/// Registry keys of the snapshots taken at the end of Initialize(); scripts cannot reach the registry.
+constexpr const char* kGlobalsSnapshot = "ccad.globals";
+constexpr const char* kBuiltinModules = "ccad.builtin_modules";
+
+/// VM instructions between two cancellation checks; cheap enough to be unnoticeable.
+constexpr int kCancelCheckInstructions = 1000;
+
+/// Count hook: abort the script once the calling thread's OperationContext is cancelled.
+void CancelHook(lua_State* L, lua_Debug* /*ar*/) {
+    if (IsCancelled()) luaL_error(L, "cancelled");
 }
 
+using Clock = std::chrono::high_resolution_clock;
+
+/// Log a finished run; op cache activity is counted on this thread only, so concurrent engines report their own.
+void LogRun(const std::string& name, Clock::time_point start, const KernelStats& before) {
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+    const auto stats = GetThreadKernelStats();
+    LOG(INFO) << "[LuaEngine] " << name << " processing time: " << ms << "ms (op cache: "
+              << stats.opCacheHits - before.opCacheHits << " hits, " << stats.opCacheMisses - before.opCacheMisses
+              << " misses, " << stats.opCacheSavedMs - before.opCacheSavedMs << "ms saved)";
+}
+
+}  // namespace
+
+LuaEngine::LuaEngine() = default;
+
 LuaEngine::~LuaEngine() = default;
 
 void LuaEngine::SetLibraryPaths(const std::vector<std::string>& paths) {
@@ -38,6 +67,7 @@ bool LuaEngine::Initialize(std::string* errorMsg) {
     try {
         m_Lua.open_libraries(sol::lib::base, sol::lib::math, sol::lib::table, sol::lib::package, sol::lib::string,
                              sol::lib::io);
+        lua_sethook(m_Lua.lua_state(), &CancelHook, LUA_MASKCOUNT, kCancelCheckInstructions);
 
         if (!m_LibraryPaths.empty()) {
             std::string current = m_Lua["package"]["path"].get<std::string>();
@@ -46,6 +76,32 @@ bool LuaEngine::Initialize(std::string* errorMsg) {
 
         m_Lua.create_named_table("PARAMS");
 
+        // Record the modules each run requires, including those nested in already loaded modules,
+        // so callers can tell which library files a part depends on (see RequiredModules()).
+        m_Lua.script(R"(
+            local rawRequire, deps, stack = require, {}, {}
+            __CCAD_REQUIRED = {}
+            local function mark(name, seen)
+                if seen[name] then return end
+                seen[name] = true
+                __CCAD_REQUIRED[name] = true
+                for child in pairs(deps[name] or {}) do mark(child, seen) end
+            end
+            require = function(name)
+                local parent = stack[#stack]
+                if parent then
+                    deps[parent] = deps[parent] or {}
+                    deps[parent][name] = true
+                end
+                stack[#stack + 1] = name
+                local ok, res = pcall(rawRequire, name)
+                stack[#stack] = nil
+                if not ok then error(res, 0) end
+                mark(name, {})
+                return res
+            end
+        )");
+
         m_Lua.set_function("mm", [](double v) { return v; });
         m_Lua.set_function("deg", [](double v) { return v; });
 
@@ -88,10 +144,18 @@ bool LuaEngine::Initialize(std::string* errorMsg) {
         RegisterFeatures(m_Lua);
         RegisterMeasure(m_Lua);
         RegisterSketch(m_Lua);
-        RegisterSelect(m_Lua);
+        RegisterSelect(m_Lua, this);
         RegisterCurves(m_Lua);
         RegisterMech(m_Lua);
 
+        // Snapshots for BeginRun(): the globals and the modules loaded before any script ran
+        sol::table globals = m_Lua.create_table();
+        for (const auto& kv : m_Lua.globals()) globals[kv.first] = kv.second;
+        m_Lua.registry()[kGlobalsSnapshot] = globals;
+        sol::table builtin = m_Lua.create_table();
+        for (const auto& kv : m_Lua["package"]["loaded"].get<sol::table>()) builtin[kv.first] = true;
+        m_Lua.registry()[kBuiltinModules] = builtin;
+
         m_Initialized = true;
         return true;
     } catch (const std::exception& e) {
@@ -109,8 +173,10 @@ bool LuaEngine::RunFile(const std::string& scriptPath) {
         return false;
     }
 
-    using clock = std::chrono::high_resolution_clock;
-    auto start = clock::now();
+    const auto start = Clock::now();
+    const auto statsBefore = GetThreadKernelStats();
+    BeginRun(/*resetGlobals*/ true);
+    m_Emitted = Shape();  // an engine reused for several files must not hand out the previous result
 
     sol::load_result chunk = m_Lua.load_file(scriptPath);
     if (!chunk.valid()) {
@@ -121,15 +187,10 @@ bool LuaEngine::RunFile(const std::string& scriptPath) {
 
     sol::protected_function_result result = chunk();
     if (!result.valid()) {
-        auto pretty = FormatLuaError(m_Lua, result);
-        PrintLuaErrorPretty(pretty);
+        ReportError(result);
         return false;
     }
-    auto end = clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-
-    std::filesystem::path partFile{scriptPath};
-    LOG(INFO) << "[LuaEngine] " << partFile.filename() << " processing time: " << ms << "ms";
+    LogRun(std::filesystem::path{scriptPath}.filename().string(), start, statsBefore);
     return true;
 }
 
@@ -138,6 +199,9 @@ bool LuaEngine::RunString(const std::string& script) {
         LOG(ERROR) << "CoreEngine is not initialized";
         return false;
     }
+    const auto start = Clock::now();
+    const auto statsBefore = GetThreadKernelStats();
+    BeginRun(/*resetGlobals*/ false);
     sol::load_result chunk = m_Lua.load(script.c_str());
     if (!chunk.valid()) {
         sol::error err = chunk;
@@ -147,17 +211,53 @@ bool LuaEngine::RunString(const std::string& script) {
 
     sol::protected_function_result result = chunk();
     if (!result.valid()) {
-        auto pretty = FormatLuaError(m_Lua, result);
-        PrintLuaErrorPretty(pretty);
+        ReportError(result);
         return false;
     }
+    LogRun("<string>", start, statsBefore);
     return true;
 }
 
+void LuaEngine::BeginRun(bool resetGlobals) {
+    m_EdgeSelectors.Clear();
+    const auto previous = RequiredModules();
+
+    if (resetGlobals) {
+        // Globals the previous file defined go away, those it overwrote (even `print`) come back
+        sol::table snapshot = m_Lua.registry()[kGlobalsSnapshot];
+        sol::table globals = m_Lua.globals();
+        std::vector<sol::object> added;
+        for (const auto& kv : globals) {
+            if (snapshot.raw_get<sol::object>(kv.first).get_type() == sol::type::lua_nil) added.push_back(kv.first);
+        }
+        for (const auto& k : added) globals.raw_set(k, sol::lua_nil);
+        for (const auto& kv : snapshot) globals.raw_set(kv.first, kv.second);
+    }
+
+    // Standard libraries stay loaded, `require("string")` has no file to reload them from
+    sol::table loaded = m_Lua["package"]["loaded"];
+    sol::table builtin = m_Lua.registry()[kBuiltinModules];
+    for (const auto& name : previous) {
+        if (!builtin.raw_get<sol::optional<bool>>(name)) loaded[name] = sol::lua_nil;
+    }
+    m_Lua["__CCAD_REQUIRED"] = m_Lua.create_table();
+}
+
+void LuaEngine::ReportError(sol::protected_function_result& result) {
+    // A cancelled run was abandoned on purpose, its error is not the script's fault
+    if (IsCancelled()) {
+        LOG(INFO) << "[LuaEngine] run cancelled";
+        return;
+    }
+    auto pretty = FormatLuaError(m_Lua, result);
+    PrintLuaErrorPretty(pretty);
+}
+
 void LuaEngine::Reset() {
     // Recreate state & bindings
     m_Lua = sol::state{};
     m_Initialized = false;
+    m_EdgeSelectors.Clear();
     // Re-init with previous config
     std::string err;
     if (!Initialize(&err)) {
@@ -167,7 +267,31 @@ void LuaEngine::Reset() {
 }
 
 std::optional<Shape> LuaEngine::GetEmitted() const {
-    return m_Emitted;
+    if (!m_Emitted) return std::nullopt;
+    return m_Emitted;  // shares the shape, no deep copy
+}
+
+std::vector<std::string> LuaEngine::RequiredModules() {
+    std::vector<std::string> names;
+    sol::optional<sol::table> required = m_Lua["__CCAD_REQUIRED"];
+    if (!required) return names;
+    for (const auto& kv : *required) {
+        if (kv.first.is<std::string>()) names.push_back(kv.first.as<std::string>());
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+std::vector<std::string> LuaEngine::RequiredModuleFiles() {
+    std::vector<std::string> files;
+    sol::protected_function searchpath = m_Lua["package"]["searchpath"];
+    const std::string path = m_Lua["package"]["path"];
+    for (const auto& name : RequiredModules()) {
+        // Modules without a Lua file (preloaded or native) are skipped
+        sol::protected_function_result r = searchpath(name, path);
+        if (r.valid() && r.get_type() == sol::type::string) files.push_back(r.get<std::string>());
+    }
+    return files;
 }
 
 void LuaEngine::SetEmitted(const Shape& s) {
@@ -179,7 +303,19 @@ geom::TriMesh LuaEngine::TriangulateEmitted() const {
         throw std::runtime_error("TriangulateEmitted: no shape has been emitted");
     }
 
-    return geom::Triangulate(m_Emitted, GetTriangulationParameters());
+    return geom::Triangulate(m_Emitted, m_MeshParams);
+}
+
+void LuaEngine::SetTriangulationParameters(const geom::TriangulationParams& p) {
+    m_MeshParams = p;
+}
+
+const geom::TriangulationParams& LuaEngine::TriangulationParameters() const {
+    return m_MeshParams;
+}
+
+select::EdgeSelectorCache& LuaEngine::EdgeSelectors() {
+    return m_EdgeSelectors;
 }
 
 sol::state& LuaEngine::Lua() {
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <ccad/lua/LuaEngine.hpp>
+#include <filesystem>
+#include <fstream>
 
 using namespace std;
 using namespace ccad::lua;
@@ -12,3 +14,88 @@ TEST(TestLua, Basic) {
     auto s = e.GetEmitted();
     ASSERT_TRUE((bool)s);
 }
+
+TEST(TestLua, EdgeSelectorsShareIndex) {
+    LuaEngine e;
+    ASSERT_TRUE(e.Initialize());
+    ASSERT_TRUE(e.RunString(R"(
+        local b = box(10, 10, 10)
+        top = edges(b):on_box_side("zmax"):collect()
+        vert = edges(b):parallel("z"):collect()
+        emit(fillet(b, vert:unite(top), 1))
+    )"));
+    EXPECT_TRUE((bool)e.GetEmitted());
+    EXPECT_EQ(e.EdgeSelectors().Size(), 1u);
+}
+
+TEST(TestLua, ShellRejectsNonFaceSet) {
+    LuaEngine e;
+    ASSERT_TRUE(e.Initialize());
+    EXPECT_TRUE(e.RunString("emit(shell(box(10, 10, 10), nil, 1))"));
+    EXPECT_FALSE(e.RunString("emit(shell(box(10, 10, 10), 5, 1))"));
+}
+
+TEST(TestLua, RequiredModulesAreTransitive) {
+    LuaEngine e;
+    ASSERT_TRUE(e.Initialize());
+    ASSERT_TRUE(e.RunString(R"(
+        package.preload["outer"] = function() return require("inner") end
+        package.preload["inner"] = function() return 42 end
+    )"));
+    EXPECT_TRUE(e.RequiredModules().empty());
+
+    ASSERT_TRUE(e.RunString("assert(require('outer') == 42)"));
+    EXPECT_EQ(e.RequiredModules(), (vector<string>{"inner", "outer"}));
+
+    // Required again: the modules are loaded afresh and the nested dependency is still reported
+    ASSERT_TRUE(e.RunString("require('outer')"));
+    EXPECT_EQ(e.RequiredModules(), (vector<string>{"inner", "outer"}));
+    EXPECT_TRUE(e.RequiredModuleFiles().empty());
+}
+
+TEST(TestLua, RunFileReloadsEditedModules) {
+    const auto dir = std::filesystem::temp_directory_path() / "ccad_reload";
+    std::filesystem::create_directories(dir);
+    const auto script = dir / "part.lua";
+    std::ofstream(script) << "emit(box(require('size'), 1, 1))\n";
+    std::ofstream(dir / "size.lua") << "return 10\n";
+
+    LuaEngine e;
+    e.SetLibraryPaths({(dir / "?.lua").string()});
+    ASSERT_TRUE(e.Initialize());
+    ASSERT_TRUE(e.RunFile(script.string()));
+    EXPECT_NEAR(e.GetEmitted()->BBox().Size().x, 10.0, 1e-6);
+
+    std::ofstream(dir / "size.lua") << "return 20\n";
+    ASSERT_TRUE(e.RunFile(script.string()));
+    EXPECT_NEAR(e.GetEmitted()->BBox().Size().x, 20.0, 1e-6);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(TestLua, RunFileResetsGlobals) {
+    const auto dir = std::filesystem::temp_directory_path();
+    const auto first = dir / "ccad_globals_first.lua";
+    const auto second = dir / "ccad_globals_second.lua";
+    std::ofstream(first) << "leaked = 1\nprint = nil\n";
+    std::ofstream(second) << "assert(leaked == nil and print ~= nil)\nassert(require('string') == string)\n";
+
+    LuaEngine e;
+    ASSERT_TRUE(e.Initialize());
+    ASSERT_TRUE(e.RunFile(first.string()));
+    ASSERT_TRUE(e.RunFile(second.string()));
+    ASSERT_TRUE(e.RunFile(second.string()));  // a standard library survives the module reset
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
+TEST(TestLua, RunFileClearsEmitted) {
+    LuaEngine e;
+    ASSERT_TRUE(e.Initialize());
+    const auto script = std::filesystem::temp_directory_path() / "ccad_no_emit.lua";
+    std::ofstream(script) << "local b = box(1, 1, 1)\n";
+
+    ASSERT_TRUE(e.RunString("emit(box(10,10,10))"));
+    ASSERT_TRUE(e.RunFile(script.string()));
+    EXPECT_FALSE((bool)e.GetEmitted());  // a reused engine does not report the previous shape
+    std::filesystem::remove(script);
+}
@@ -12,9 +12,8 @@ PureMesh::~PureMesh() {
 
 void PureMesh::Upload(std::vector<PureVertex>& vertices, const std::vector<unsigned>& indices,
                       bool recalculateNormals) {
-    m_Vertices = vertices;
-    m_Indices = indices;
     if (recalculateNormals) {
+        // Area-weighted vertex normals: accumulate unnormalized face normals, normalize once
         for (auto& v : vertices) {
             v.normal = glm::vec3(0.0f);
         }
@@ -28,16 +27,20 @@ void PureMesh::Upload(std::vector<PureVertex>& vertices, const std::vector<unsig
             const glm::vec3& p1 = vertices[i1].position;
             const glm::vec3& p2 = vertices[i2].position;
 
-            glm::vec3 edge1 = p1 - p0;
-            glm::vec3 edge2 = p2 - p0;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
 
-            glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+            vertices[i0].normal += normal;
+            vertices[i1].normal += normal;
+            vertices[i2].normal += normal;
+        }
 
-            vertices[i0].normal = normal;
-            vertices[i1].normal = normal;
-            vertices[i2].normal = normal;
+        for (auto& v : vertices) {
+            float len = glm::length(v.normal);
+            if (len > 0.0f) v.normal /= len;
         }
     }
+    m_Vertices = vertices;
+    m_Indices = indices;
 
     if (!m_Vao) glGenVertexArrays(1, &m_Vao);
     if (!m_Vbo) glGenBuffers(1, &m_Vbo);
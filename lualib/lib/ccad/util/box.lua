@@ -116,6 +116,14 @@ function M.rounded_shell(w, d, h, t, r, seg, open_top)
 		return outer -- walls too big
 	end
 
+	if not open_top and t > 0 and h > t then
+		-- one offset instead of a boolean; falls back below if the offset fails
+		local ok, cup = pcall(shell, outer, faces(outer):on_box_side("zmax"):collect(), t)
+		if ok then
+			return cup
+		end
+	end
+
 	local ri = math.max(0, r - t) -- inner radius reduced by wall
 	local inner_face = M.rounded_rect_face(wi, di, ri, seg)
 	local hi = open_top and h or (h - t)
@@ -4,14 +4,13 @@
 
 local M = {}
 
--- Internal: fold-union over a list, must not be empty
+-- Internal: union over a list in a single kernel call, must not be empty
 local function union_list(list)
 	assert(#list > 0, "union_list called with empty list")
-	local acc = list[1]
-	for i = 2, #list do
-		acc = union(acc, list[i])
+	if #list == 1 then
+		return list[1]
 	end
-	return acc
+	return union(list)
 end
 
 ----------------------------------------------------------------------
@@ -31,20 +30,7 @@ end
 --- @param sc? number @uniform scale
 --- @return Shape
 function M.place(s, x, y, z, rx, ry, rz, sc)
-	local t = s
-	if sc and sc ~= 1 then
-		t = scale(t, sc)
-	end
-	if rx and rx ~= 0 then
-		t = rotate_x(t, rx)
-	end
-	if ry and ry ~= 0 then
-		t = rotate_y(t, ry)
-	end
-	if rz and rz ~= 0 then
-		t = rotate_z(t, rz)
-	end
-	return translate(t, x or 0, y or 0, z or 0)
+	return transform(s, { x = x, y = y, z = z, rx = rx, ry = ry, rz = rz, scale = sc })
 end
 
 ----------------------------------------------------------------------
@@ -52,9 +38,10 @@ end
 ----------------------------------------------------------------------
 
 --- Create a 1D array along X; optionally replicated along Y (grid).
---- The maker function is called as `make(i, j)` with 0-based indices.
+--- `make` is either a Shape, which is instanced natively (all copies share one geometry),
+--- or a maker function called as `make(i, j)` with 0-based indices for per-instance variation.
 --- If `ny` is nil or <=1, only one row along X is produced.
---- @param make fun(i:integer, j:integer): Shape
+--- @param make Shape|fun(i:integer, j:integer): Shape
 --- @param nx integer @number of items in X (>=1)
 --- @param dx number  @spacing in X [mm]
 --- @param ny? integer @rows in Y (>=1)
@@ -66,29 +53,24 @@ function M.array(make, nx, dx, ny, dy)
 	ny = ny or 1
 	dy = dy or 0
 
-	-- Build one row
-	local row = {}
-	for i = 0, nx - 1 do
-		local s = make(i, 0)
-		row[#row + 1] = translate(s, i * dx, 0, 0)
-	end
-	local row_union = union_list(row)
-
-	if ny <= 1 then
-		return row_union
+	if type(make) ~= "function" then
+		return grid_pattern(make, nx, dx, ny, dy, true)
 	end
 
-	-- Replicate rows
-	local rows = {}
+	-- Collect all instances, then fuse them in one pass
+	local parts = {}
 	for j = 0, ny - 1 do
-		rows[#rows + 1] = translate(row_union, 0, j * dy, 0)
+		for i = 0, nx - 1 do
+			local s = make(i, j)
+			parts[#parts + 1] = translate(s, i * dx, j * dy, 0)
+		end
 	end
-	return union_list(rows)
+	return union_list(parts)
 end
 
---- 2D grid (X/Y) using a maker function `(i, j) -> Shape`.
+--- 2D grid (X/Y) using a Shape or a maker function `(i, j) -> Shape`.
 --- Convenience wrapper around `array`.
---- @param make fun(i:integer, j:integer): Shape
+--- @param make Shape|fun(i:integer, j:integer): Shape
 --- @param nx integer
 --- @param dx number
 --- @param ny integer
@@ -104,10 +86,11 @@ end
 
 --- Place `n` instances around a circle of radius `r` in the XY-plane.
 --- Angle 0° points along +X; increases CCW.
---- The maker function is called as `make(i, angle_deg)` with i in [0..n-1].
+--- `make` is either a Shape, which is instanced natively (translated only, like maker results),
+--- or a maker function called as `make(i, angle_deg)` with i in [0..n-1].
 --- @param n integer  @number of items (>=1)
 --- @param r number   @radius [mm]
---- @param make fun(i:integer, angle_deg:number): Shape
+--- @param make Shape|fun(i:integer, angle_deg:number): Shape
 --- @param angle0? number @start angle (deg), default 0
 --- @return Shape
 function M.polar(n, r, make, angle0)
@@ -115,6 +98,10 @@ function M.polar(n, r, make, angle0)
 	assert(r and r >= 0, "polar: r must be >= 0")
 	angle0 = angle0 or 0
 
+	if type(make) ~= "function" then
+		return polar_pattern(make, n, r, angle0, false, true)
+	end
+
 	local parts = {}
 	for i = 0, n - 1 do
 		local a = angle0 + i * (360 / n)
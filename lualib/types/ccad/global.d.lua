@@ -36,6 +36,13 @@ It is not executed at runtime.
 ---@field size   Vec3                    # Size along axes (width, depth, height)
 ---@field center Vec3                    # Box center in world coordinates
 
+---@class Topology
+---@field solids   integer
+---@field shells   integer
+---@field faces    integer
+---@field edges    integer
+---@field vertices integer
+
 --==============================================================
 -- PRIMITIVES
 --==============================================================
@@ -210,21 +217,74 @@ function rotate_z(s, deg) end
 ---@return Shape
 function scale(s, factor) end
 
+--- Place a shape in one step: uniform scale, then rotate about X, Y, Z (degrees), then translate.
+--- Rigid placements share geometry with `s`; scaling or `copy = true` creates an independent copy.
+---@param s Shape
+---@param t {x?: number, y?: number, z?: number, rx?: number, ry?: number, rz?: number, scale?: number, copy?: boolean}
+---@return Shape
+function transform(s, t) end
+
+--- Repeat a shape `n` times, instance i translated by i * (dx, dy, dz).
+--- Instances share one geometry; the result is a compound unless `fuse` is true.
+---@param s Shape
+---@param n integer
+---@param dx number
+---@param dy number
+---@param dz number
+---@param fuse? boolean Union all instances (default false)
+---@return Shape
+function linear_pattern(s, n, dx, dy, dz, fuse) end
+
+--- Repeat a shape on an nx * ny grid in the XY plane.
+---@param s Shape
+---@param nx integer
+---@param dx number
+---@param ny integer
+---@param dy number
+---@param fuse? boolean Union all instances (default false)
+---@return Shape
+function grid_pattern(s, nx, dx, ny, dy, fuse) end
+
+--- Repeat a shape `n` times on a circle of radius `r` around the Z axis (0° = +X, CCW).
+---@param s Shape
+---@param n integer
+---@param r number
+---@param start_deg? number Angle of the first instance (default 0)
+---@param orient? boolean Rotate instances with the angle (default true), otherwise only translate
+---@param fuse? boolean Union all instances (default false)
+---@return Shape
+function polar_pattern(s, n, r, start_deg, orient, fuse) end
+
+--- Mirror a shape at the plane with normal (nx, ny, nz) through point (px, py, pz) (default origin).
+---@param s Shape
+---@param nx number
+---@param ny number
+---@param nz number
+---@param px? number
+---@param py? number
+---@param pz? number
+---@return Shape
+function mirror(s, nx, ny, nz, px, py, pz) end
+
 --==============================================================
 -- BOOLEANS
 --==============================================================
 
 --- Union (OR) of two or more shapes.
+--- All shapes are fused in a single pass; pass a list (`union({a, b, c})`) to fuse many shapes at once.
 ---@param a Shape
 ---@param b Shape
 ---@param ... Shape  @optional additional shapes
 ---@return Shape
+---@overload fun(shapes: Shape[]): Shape
 function union(a, b, ...) end
 
 --- Subtract `b` from `a` (A \ B).
+--- Pass a list of tools (`difference(body, {t1, t2, ...})`) to cut them all in one pass.
 ---@param a Shape
 ---@param b Shape
 ---@return Shape
+---@overload fun(a: Shape, tools: Shape[]): Shape
 function difference(a, b) end
 
 --- Intersection (AND) of two shapes.
@@ -253,6 +313,25 @@ function chamfer_all(s, d) end
 ---@class EdgeSet
 local EdgeSet = {}
 
+--- Number of selected edges.
+---@return integer
+function EdgeSet:size() end
+
+--- Edges in either set (new set).
+---@param other EdgeSet
+---@return EdgeSet
+function EdgeSet:unite(other) end
+
+--- Edges in both sets (new set).
+---@param other EdgeSet
+---@return EdgeSet
+function EdgeSet:intersect(other) end
+
+--- Edges of this set not in `other` (new set).
+---@param other EdgeSet
+---@return EdgeSet
+function EdgeSet:subtract(other) end
+
 ---@class EdgeQuery
 local EdgeQuery = {}
 
@@ -269,9 +348,9 @@ function EdgeQuery:from(shape) end
 --- Filter edges lying on a specific AABB side of the shape's bounding box.
 --- Valid sides: "xmin","xmax","ymin","ymax","zmin","zmax".
 ---@param side '"xmin"'|'"xmax"'|'"ymin"'|'"ymax"'|'"zmin"'|'"zmax"'
----@param tolerance_mm? number  -- reserved for future use
+---@param tol_mm? number  default 1e-6
 ---@return EdgeQuery
-function EdgeQuery:on_box_side(side, tolerance_mm) end
+function EdgeQuery:on_box_side(side, tol_mm) end
 
 --- Filter by geometric type.
 --- "line" selects straight edges, "circle" selects circular arcs.
@@ -297,6 +376,27 @@ function EdgeQuery:dihedral_between(min_deg, max_deg) end
 ---@return EdgeQuery
 function EdgeQuery:length_between(min_mm, max_mm) end
 
+--- Filter circular edges by radius interval (in mm).
+---@param min_mm number
+---@param max_mm number
+---@return EdgeQuery
+function EdgeQuery:radius_between(min_mm, max_mm) end
+
+--- Filter edges whose sample point lies on the plane axis=value (default tolerance 0.001 mm).
+---@param axis '"x"'|'"y"'|'"z"'
+---@param value number
+---@param tol_mm? number
+---@return EdgeQuery
+function EdgeQuery:near_plane(axis, value, tol_mm) end
+
+--- Filter edges whose sample point lies inside an axis-aligned box.
+---@return EdgeQuery
+function EdgeQuery:inside_box(x0, y0, z0, x1, y1, z1) end
+
+--- Filter edges within `radius_mm` of a point.
+---@return EdgeQuery
+function EdgeQuery:near_point(x, y, z, radius_mm) end
+
 --- Finalize and return the selected set of edges.
 ---@return EdgeSet
 function EdgeQuery:collect() end
@@ -315,6 +415,90 @@ function fillet(shape, edges, radius_mm) end
 ---@return Shape
 function chamfer(shape, edges, distance_mm) end
 
+---@class FaceSet
+local FaceSet = {}
+
+--- Number of selected faces.
+---@return integer
+function FaceSet:size() end
+
+---@param other FaceSet
+---@return FaceSet
+function FaceSet:unite(other) end
+
+---@param other FaceSet
+---@return FaceSet
+function FaceSet:intersect(other) end
+
+---@param other FaceSet
+---@return FaceSet
+function FaceSet:subtract(other) end
+
+---@class FaceQuery
+local FaceQuery = {}
+
+--- Start a new face-query builder (optionally with a source shape).
+---@overload fun(): FaceQuery
+---@param shape Shape
+---@return FaceQuery
+function faces(shape) end
+
+---@param shape Shape
+---@return FaceQuery
+function FaceQuery:from(shape) end
+
+--- Filter by surface type.
+---@param kind '"plane"'|'"cylinder"'|'"cone"'|'"sphere"'|'"torus"'|'"other"'
+---@return FaceQuery
+function FaceQuery:geom(kind) end
+
+--- Filter faces whose normal is parallel to an axis (either direction).
+---@param axis '"x"'|'"y"'|'"z"'
+---@param tol_deg? number  default 3
+---@return FaceQuery
+function FaceQuery:normal(axis, tol_deg) end
+
+--- Filter faces whose centroid lies on a side of the shape's bounding box.
+---@param side '"xmin"'|'"xmax"'|'"ymin"'|'"ymax"'|'"zmin"'|'"zmax"'
+---@param tol_mm? number  default 1e-6
+---@return FaceQuery
+function FaceQuery:on_box_side(side, tol_mm) end
+
+--- Filter by face area interval (in mm²).
+---@param min_mm2 number
+---@param max_mm2 number
+---@return FaceQuery
+function FaceQuery:area_between(min_mm2, max_mm2) end
+
+--- Keep faces sharing an edge with any face of `seeds`.
+---@param seeds FaceSet
+---@return FaceQuery
+function FaceQuery:adjacent_to(seeds) end
+
+--- After all other filters, keep the `n` largest faces (default 1).
+---@param n? integer
+---@return FaceQuery
+function FaceQuery:largest(n) end
+
+--- Filter faces within `radius_mm` of a point.
+---@return FaceQuery
+function FaceQuery:near_point(x, y, z, radius_mm) end
+
+--- Filter faces hit by the ray origin + t * dir; `first` keeps only the nearest hit.
+---@param first? boolean
+---@return FaceQuery
+function FaceQuery:hit_by_ray(ox, oy, oz, dx, dy, dz, first) end
+
+---@return FaceSet
+function FaceQuery:collect() end
+
+--- Hollow a solid to a wall thickness; the selected faces become openings.
+---@param shape Shape
+---@param open_faces FaceSet|nil  nil keeps a closed cavity
+---@param thickness_mm number
+---@return Shape
+function shell(shape, open_faces, thickness_mm) end
+
 --==============================================================
 -- SKETCH (2D profiles)
 --==============================================================
@@ -364,10 +548,11 @@ function revolve(profile, angle_deg) end
 ---@param s Shape
 function emit(s) end
 
---- Save a shape as STL (triangulated).
+--- Save a shape as STL (triangulated). Writes binary STL unless `opts.ascii` is set.
 ---@param s    Shape
 ---@param path string Absolute or relative filesystem path
-function save_stl(s, path) end
+---@param opts? {ascii?: boolean}
+function save_stl(s, path, opts) end
 
 --- Save a shape as STEP (B-Rep).
 ---@param s    Shape
@@ -405,6 +590,31 @@ function deg(v) end
 ---@return BBox
 function bbox(s) end
 
+--- Volume of a shape [mm³] (cached on the shape).
+---@param s Shape
+---@return number
+function volume(s) end
+
+--- Total surface area of a shape [mm²] (cached on the shape).
+---@param s Shape
+---@return number
+function surface_area(s) end
+
+--- Volume centroid (area centroid for shapes without volume).
+---@param s Shape
+---@return Vec3
+function centroid(s) end
+
+--- True if the shape passes the full topology and geometry check.
+---@param s Shape
+---@return boolean
+function is_valid(s) end
+
+--- Number of distinct solids, shells, faces, edges and vertices.
+---@param s Shape
+---@return Topology
+function topology(s) end
+
 --- Center a shape along X around 0 (translates by half width).
 ---@param s Shape
 ---@return Shape